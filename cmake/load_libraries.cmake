@@ -10,9 +10,14 @@ find_package(LLVM REQUIRED CONFIG)
 message(STATUS "Found LLVM ${LLVM_PACKAGE_VERSION}")
 message(STATUS "Using LLVMConfig.cmake in: ${LLVM_DIR}")
 
-llvm_map_components_to_libnames(llvm_libs support core linker)
+llvm_map_components_to_libnames(llvm_libs support core linker bitreader bitwriter passes lto
+        target codegen all-targets orcjit)
 # -- llvm end --
 
+# -- threads --
+find_package(Threads REQUIRED)
+# -- threads end --
+
 # -- fmt --
 set(CMAKE_POSITION_INDEPENDENT_CODE TRUE)
 add_subdirectory(lib/fmt EXCLUDE_FROM_ALL)
@@ -0,0 +1,691 @@
+#include "ASTSerializer.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "profiling/AllocationProfiler.h"
+
+namespace Front {
+namespace {
+// kind value that is used to encode nullptr children
+constexpr size_t kNullNode = ASTNode::Kind::count;
+
+class ASTWriter : Serializer {
+  std::ostream& os_;
+  const ModuleContext& context_;
+
+  // only declarations that are visible to importers are written
+  bool is_interface_;
+
+  // all members of exported namespace are visible to importers
+  bool is_in_exported_namespace_{false};
+
+  std::unordered_map<StringId, size_t> strings_;
+
+  void write(size_t value) { write_varint(value, os_); }
+
+  void write_signed(int64_t value) {
+    // zigzag encoding keeps small negative numbers short
+    write((static_cast<uint64_t>(value) << 1) ^
+          static_cast<uint64_t>(value >> 63));
+  }
+
+  // string is written only when it is encountered for the first time
+  // after that only its index is written
+  void write_string(StringId id) {
+    auto [itr, was_emplaced] = strings_.emplace(id, strings_.size());
+    write(itr->second);
+
+    if (was_emplaced) {
+      std::string_view string = context_.get_string(id);
+      write(string.size());
+      os_.write(string.data(), string.size());
+    }
+  }
+
+  void write_id(const QualifiedId& id) {
+    write(id.parts.size());
+    for (StringId part : id.parts) {
+      write_string(part);
+    }
+  }
+
+  void write_range(SourceRange range) {
+    // positions are meaningless without the source, so they are dropped
+    if (is_interface_) {
+      range = {};
+    }
+
+    write(range.begin.pos_id);
+    write(range.end.pos_id - range.begin.pos_id);
+  }
+
+  void write_declaration(const Declaration& node, bool is_extern = false) {
+    is_extern |= node.specifiers.is_extern();
+
+    write_string(node.name);
+    write(static_cast<size_t>(node.specifiers.is_exported()) |
+          static_cast<size_t>(is_extern) << 1);
+  }
+
+  // types may be referenced from exported signatures, so they are always
+  // kept, functions and variables are kept only when visible
+  bool is_part_of_interface(const Declaration& node) const {
+    if (!node.get_kind().in<ASTNode::Kind::FUNCTION_DECL,
+                            ASTNode::Kind::VARIABLE_DECL>()) {
+      return true;
+    }
+
+    return is_in_exported_namespace_ || node.specifiers.is_exported();
+  }
+
+  void write_declarations(
+      const std::vector<std::unique_ptr<Declaration>>& nodes) {
+    if (!is_interface_) {
+      write_nodes(nodes);
+      return;
+    }
+
+    write(std::ranges::count_if(
+        nodes, [this](const auto& node) { return is_part_of_interface(*node); }));
+
+    for (const auto& node : nodes) {
+      if (is_part_of_interface(*node)) {
+        write_node(node.get());
+      }
+    }
+  }
+
+  template <typename T>
+  void write_nodes(const std::vector<std::unique_ptr<T>>& nodes) {
+    write(nodes.size());
+    for (const auto& node : nodes) {
+      write_node(node.get());
+    }
+  }
+
+  // program
+  void write_program(const ProgramNode& node) {
+    write_nodes(node.imports);
+    write_declarations(node.declarations);
+  }
+
+  // declarations
+  void write_function_declaration(const FunctionDecl& node) {
+    // in interface functions become extern declarations
+    write_declaration(node, is_interface_);
+    write_nodes(node.parameters);
+    write_node(node.return_type.get());
+    write_node(is_interface_ ? nullptr : node.body.get());
+  }
+
+  void write_import_declaration(const ImportDecl& node) {
+    write_declaration(node);
+  }
+
+  void write_variable_declaration(const VariableDecl& node) {
+    write_declaration(node);
+    write_node(node.type.get());
+    write_node(is_interface_ ? nullptr : node.initializer.get());
+  }
+
+  void write_namespace_declaration(const NamespaceDecl& node) {
+    write_declaration(node);
+
+    bool was_in_exported_namespace = is_in_exported_namespace_;
+    is_in_exported_namespace_ |= node.specifiers.is_exported();
+
+    write_declarations(node.body);
+
+    is_in_exported_namespace_ = was_in_exported_namespace;
+  }
+
+  void write_type_alias_declaration(const TypeAliasDecl& node) {
+    write_declaration(node);
+    write_node(node.original.get());
+  }
+
+  void write_class_declaration(const ClassDecl& node) {
+    write_declaration(node);
+    write_nodes(node.body);
+  }
+
+  // statements
+  void write_while_statement(const WhileStmt& node) {
+    write_node(node.condition.get());
+    write_node(node.body.get());
+  }
+
+  void write_if_statement(const IfStmt& node) {
+    write_node(node.condition.get());
+    write_node(node.true_branch.get());
+    write_node(node.false_branch.get());
+  }
+
+  void write_break_statement(const BreakStmt&) {}
+
+  void write_continue_statement(const ContinueStmt&) {}
+
+  void write_compound_statement(const CompoundStmt& node) {
+    write_nodes(node.statements);
+  }
+
+  void write_return_statement(const ReturnStmt& node) {
+    write_node(node.value.get());
+  }
+
+  void write_assignment_statement(const AssignmentStmt& node) {
+    write_node(node.left.get());
+    write_node(node.right.get());
+  }
+
+  void write_declaration_statement(const DeclarationStmt& node) {
+    write_node(node.value.get());
+  }
+
+  void write_expression_statement(const ExpressionStmt& node) {
+    write_node(node.value.get());
+  }
+
+  // expressions
+  void write_integer_literal(const IntegerLiteral& node) {
+    write_signed(node.value);
+  }
+
+  void write_string_literal(const StringLiteral& node) {
+    write_string(node.id);
+  }
+
+  void write_bool_literal(const BoolLiteral& node) { write(node.value); }
+
+  void write_id_expression(const IdExpr& node) { write_id(node.id); }
+
+  void write_binary_operator(const BinaryOperator& node) {
+    write(static_cast<size_t>(node.op_type));
+    write_node(node.left.get());
+    write_node(node.right.get());
+  }
+
+  void write_unary_operator(const UnaryOperator& node) {
+    write(static_cast<size_t>(node.op_type));
+    write_node(node.value.get());
+  }
+
+  void write_call_expression(const CallExpr& node) {
+    write_node(node.callee.get());
+    write_nodes(node.arguments);
+  }
+
+  void write_member_expression(const MemberExpr& node) {
+    write_node(node.left.get());
+    write_id(node.member);
+  }
+
+  void write_tuple_expression(const TupleExpr& node) {
+    write_nodes(node.elements);
+  }
+
+  void write_implicit_lvalue_to_rvalue_conversion_expression(
+      const ImplicitLvalueToRvalueConversionExpr& node) {
+    write_node(node.value.get());
+  }
+
+  void write_tuple_index_expression(const TupleIndexExpr& node) {
+    write_node(node.left.get());
+    write(node.index);
+  }
+
+  void write_implicit_tuple_copy_expression(
+      const ImplicitTupleCopyExpr& node) {
+    write_node(node.value.get());
+  }
+
+  // types
+  void write_pointer_type(const PointerTypeNode& node) {
+    write_node(node.child.get());
+  }
+
+  void write_primitive_type(const PrimitiveTypeNode& node) {
+    write(static_cast<size_t>(node.kind));
+    write(node.width);
+  }
+
+  void write_tuple_type(const TupleTypeNode& node) {
+    write_nodes(node.elements);
+  }
+
+  void write_user_defined_type(const UserDefinedTypeNode& node) {
+    write_id(node.name);
+  }
+
+ public:
+  ASTWriter(std::ostream& os, const ModuleContext& context, bool is_interface)
+      : os_(os), context_(context), is_interface_(is_interface) {}
+
+  void write_node(const ASTNode* node) {
+    if (node == nullptr) {
+      write(kNullNode);
+      return;
+    }
+
+    write(static_cast<size_t>(node->get_kind()));
+    write_range(node->source_range);
+
+    switch (node->get_kind()) {
+#define NODE(kind, type, snake_case)                     \
+  case ASTNode::Kind::kind:                              \
+    write_##snake_case(static_cast<const type&>(*node)); \
+    break;
+
+#include "ast/NodesList.h"
+
+#undef NODE
+      default:
+        unreachable("All nodes types are enumerated above.");
+    }
+  }
+};
+
+class ASTReader : Serializer {
+  std::istream& is_;
+  ModuleContext& context_;
+  uint32_t file_id_;
+
+  std::vector<StringId> strings_;
+
+  size_t read() {
+    size_t value = read_varint(is_);
+
+    if (!is_) {
+      throw ASTDeserializationException();
+    }
+
+    return value;
+  }
+
+  int64_t read_signed() {
+    uint64_t value = read();
+    return static_cast<int64_t>((value >> 1) ^ -(value & 1));
+  }
+
+  template <typename T>
+  T read_enum() {
+    size_t value = read();
+
+    if (value >= T::count) {
+      throw ASTDeserializationException();
+    }
+
+    return T(value);
+  }
+
+  StringId read_string() {
+    size_t index = read();
+
+    if (index < strings_.size()) {
+      return strings_[index];
+    }
+
+    if (index != strings_.size()) {
+      throw ASTDeserializationException();
+    }
+
+    std::string string(read(), '\0');
+    is_.read(string.data(), string.size());
+
+    if (!is_) {
+      throw ASTDeserializationException();
+    }
+
+    strings_.push_back(context_.add_string(string));
+    return strings_.back();
+  }
+
+  QualifiedId read_id() {
+    size_t size = read();
+    if (size == 0) {
+      throw ASTDeserializationException();
+    }
+
+    QualifiedId result;
+    result.parts.reserve(size);
+
+    for (size_t i = 0; i < size; ++i) {
+      result.parts.push_back(read_string());
+    }
+
+    return result;
+  }
+
+  SourceRange read_range() {
+    size_t begin = read();
+    size_t end = begin + read();
+
+    if (end > std::numeric_limits<uint32_t>::max()) {
+      throw ASTDeserializationException();
+    }
+
+    return {SourceLocation(file_id_, begin), SourceLocation(file_id_, end)};
+  }
+
+  // fields that are common for all declarations
+  struct DeclarationHeader {
+    StringId name;
+    DeclarationSpecifiers specifiers;
+  };
+
+  DeclarationHeader read_declaration() {
+    StringId name = read_string();
+    size_t specifiers = read();
+
+    DeclarationHeader result{name, {}};
+    result.specifiers.set_exported((specifiers & 1) != 0);
+    result.specifiers.set_extern((specifiers & 2) != 0);
+    return result;
+  }
+
+  template <typename T, typename... Args>
+  std::unique_ptr<T> make_declaration(SourceRange range,
+                                      const DeclarationHeader& header,
+                                      Args&&... args) {
+    auto result =
+        std::make_unique<T>(range, header.name, std::forward<Args>(args)...);
+    result->specifiers = header.specifiers;
+    return result;
+  }
+
+  template <typename T>
+  std::unique_ptr<T> read_node_as() {
+    std::unique_ptr<ASTNode> node = read_node();
+
+    if (!node) {
+      return nullptr;
+    }
+
+    T* casted = dynamic_cast<T*>(node.get());
+    if (casted == nullptr) {
+      throw ASTDeserializationException();
+    }
+
+    node.release();
+    return std::unique_ptr<T>(casted);
+  }
+
+  template <typename T>
+  std::vector<std::unique_ptr<T>> read_nodes() {
+    size_t size = read();
+
+    std::vector<std::unique_ptr<T>> result;
+    result.reserve(size);
+
+    for (size_t i = 0; i < size; ++i) {
+      auto node = read_node_as<T>();
+      if (!node) {
+        throw ASTDeserializationException();
+      }
+
+      result.push_back(std::move(node));
+    }
+
+    return result;
+  }
+
+  // program
+  std::unique_ptr<ASTNode> read_program(SourceRange range) {
+    auto result = std::make_unique<ProgramNode>(range);
+    result->imports = read_nodes<ImportDecl>();
+    result->declarations = read_nodes<Declaration>();
+    return result;
+  }
+
+  // declarations
+  std::unique_ptr<ASTNode> read_function_declaration(SourceRange range) {
+    auto header = read_declaration();
+    auto parameters = read_nodes<VariableDecl>();
+    auto return_type = read_node_as<TypeNode>();
+    auto body = read_node_as<CompoundStmt>();
+
+    return make_declaration<FunctionDecl>(range, header, std::move(parameters),
+                                          std::move(return_type),
+                                          std::move(body));
+  }
+
+  std::unique_ptr<ASTNode> read_import_declaration(SourceRange range) {
+    return make_declaration<ImportDecl>(range, read_declaration());
+  }
+
+  std::unique_ptr<ASTNode> read_variable_declaration(SourceRange range) {
+    auto header = read_declaration();
+    auto type = read_node_as<TypeNode>();
+    auto initializer = read_node_as<Expression>();
+
+    return make_declaration<VariableDecl>(range, header, std::move(type),
+                                          std::move(initializer));
+  }
+
+  std::unique_ptr<ASTNode> read_namespace_declaration(SourceRange range) {
+    auto header = read_declaration();
+    return make_declaration<NamespaceDecl>(range, header,
+                                           read_nodes<Declaration>());
+  }
+
+  std::unique_ptr<ASTNode> read_type_alias_declaration(SourceRange range) {
+    auto header = read_declaration();
+    return make_declaration<TypeAliasDecl>(range, header,
+                                           read_node_as<TypeNode>());
+  }
+
+  std::unique_ptr<ASTNode> read_class_declaration(SourceRange range) {
+    auto header = read_declaration();
+    return make_declaration<ClassDecl>(range, header,
+                                       read_nodes<Declaration>());
+  }
+
+  // statements
+  std::unique_ptr<ASTNode> read_while_statement(SourceRange range) {
+    auto condition = read_node_as<Expression>();
+    auto body = read_node_as<CompoundStmt>();
+
+    return std::make_unique<WhileStmt>(range, std::move(condition),
+                                       std::move(body));
+  }
+
+  std::unique_ptr<ASTNode> read_if_statement(SourceRange range) {
+    auto condition = read_node_as<Expression>();
+    auto true_branch = read_node_as<CompoundStmt>();
+    auto false_branch = read_node_as<CompoundStmt>();
+
+    return std::make_unique<IfStmt>(range, std::move(condition),
+                                    std::move(true_branch),
+                                    std::move(false_branch));
+  }
+
+  std::unique_ptr<ASTNode> read_break_statement(SourceRange range) {
+    return std::make_unique<BreakStmt>(range);
+  }
+
+  std::unique_ptr<ASTNode> read_continue_statement(SourceRange range) {
+    return std::make_unique<ContinueStmt>(range);
+  }
+
+  std::unique_ptr<ASTNode> read_compound_statement(SourceRange range) {
+    auto result = std::make_unique<CompoundStmt>(range);
+    result->statements = read_nodes<Statement>();
+    return result;
+  }
+
+  std::unique_ptr<ASTNode> read_return_statement(SourceRange range) {
+    return std::make_unique<ReturnStmt>(range, read_node_as<Expression>());
+  }
+
+  std::unique_ptr<ASTNode> read_assignment_statement(SourceRange range) {
+    auto left = read_node_as<Expression>();
+    auto right = read_node_as<Expression>();
+
+    return std::make_unique<AssignmentStmt>(range, std::move(left),
+                                            std::move(right));
+  }
+
+  std::unique_ptr<ASTNode> read_declaration_statement(SourceRange range) {
+    return std::make_unique<DeclarationStmt>(range,
+                                             read_node_as<Declaration>());
+  }
+
+  std::unique_ptr<ASTNode> read_expression_statement(SourceRange range) {
+    return std::make_unique<ExpressionStmt>(range, read_node_as<Expression>());
+  }
+
+  // expressions
+  std::unique_ptr<ASTNode> read_integer_literal(SourceRange range) {
+    return std::make_unique<IntegerLiteral>(range, read_signed());
+  }
+
+  std::unique_ptr<ASTNode> read_string_literal(SourceRange range) {
+    return std::make_unique<StringLiteral>(range, read_string());
+  }
+
+  std::unique_ptr<ASTNode> read_bool_literal(SourceRange range) {
+    return std::make_unique<BoolLiteral>(range, read() != 0);
+  }
+
+  std::unique_ptr<ASTNode> read_id_expression(SourceRange range) {
+    return std::make_unique<IdExpr>(range, read_id());
+  }
+
+  std::unique_ptr<ASTNode> read_binary_operator(SourceRange range) {
+    auto op_type = read_enum<BinaryOperator::OpType>();
+    auto left = read_node_as<Expression>();
+    auto right = read_node_as<Expression>();
+
+    return std::make_unique<BinaryOperator>(range, op_type, std::move(left),
+                                            std::move(right));
+  }
+
+  std::unique_ptr<ASTNode> read_unary_operator(SourceRange range) {
+    size_t op_type = read();
+    if (op_type > static_cast<size_t>(UnaryOperator::OpType::PREDECREMENT)) {
+      throw ASTDeserializationException();
+    }
+
+    return std::make_unique<UnaryOperator>(
+        range, static_cast<UnaryOperator::OpType>(op_type),
+        read_node_as<Expression>());
+  }
+
+  std::unique_ptr<ASTNode> read_call_expression(SourceRange range) {
+    auto callee = read_node_as<Expression>();
+    auto arguments = read_nodes<Expression>();
+
+    return std::make_unique<CallExpr>(range, std::move(callee),
+                                      std::move(arguments));
+  }
+
+  std::unique_ptr<ASTNode> read_member_expression(SourceRange range) {
+    auto left = read_node_as<Expression>();
+    auto member = read_id();
+
+    return std::make_unique<MemberExpr>(range, std::move(left),
+                                        std::move(member));
+  }
+
+  std::unique_ptr<ASTNode> read_tuple_expression(SourceRange range) {
+    return std::make_unique<TupleExpr>(range, read_nodes<Expression>());
+  }
+
+  std::unique_ptr<ASTNode> read_implicit_lvalue_to_rvalue_conversion_expression(
+      SourceRange range) {
+    return std::make_unique<ImplicitLvalueToRvalueConversionExpr>(
+        range, read_node_as<Expression>());
+  }
+
+  std::unique_ptr<ASTNode> read_tuple_index_expression(SourceRange range) {
+    auto left = read_node_as<Expression>();
+    size_t index = read();
+
+    return std::make_unique<TupleIndexExpr>(range, std::move(left), index);
+  }
+
+  std::unique_ptr<ASTNode> read_implicit_tuple_copy_expression(
+      SourceRange range) {
+    return std::make_unique<ImplicitTupleCopyExpr>(range,
+                                                   read_node_as<Expression>());
+  }
+
+  // types
+  std::unique_ptr<ASTNode> read_pointer_type(SourceRange range) {
+    return std::make_unique<PointerTypeNode>(range, read_node_as<TypeNode>());
+  }
+
+  std::unique_ptr<ASTNode> read_primitive_type(SourceRange range) {
+    auto kind = read_enum<Type::Kind>();
+    size_t width = read();
+
+    return std::make_unique<PrimitiveTypeNode>(range, kind, width);
+  }
+
+  std::unique_ptr<ASTNode> read_tuple_type(SourceRange range) {
+    return std::make_unique<TupleTypeNode>(range, read_nodes<TypeNode>());
+  }
+
+  std::unique_ptr<ASTNode> read_user_defined_type(SourceRange range) {
+    return std::make_unique<UserDefinedTypeNode>(range, read_id());
+  }
+
+ public:
+  ASTReader(std::istream& is, ModuleContext& context, uint32_t file_id)
+      : is_(is), context_(context), file_id_(file_id) {}
+
+  std::unique_ptr<ASTNode> read_node() {
+    size_t kind_index = read();
+
+    if (kind_index == kNullNode) {
+      return nullptr;
+    }
+
+    if (kind_index > kNullNode) {
+      throw ASTDeserializationException();
+    }
+
+    SourceRange range = read_range();
+
+    switch (ASTNode::Kind(kind_index)) {
+#define NODE(kind, type, snake_case) \
+  case ASTNode::Kind::kind:          \
+    return read_##snake_case(range);
+
+#include "ast/NodesList.h"
+
+#undef NODE
+      default:
+        throw ASTDeserializationException();
+    }
+  }
+};
+}  // namespace
+
+void ASTSerializer::serialize(std::ostream& os, const ModuleContext& context) {
+  ASTWriter(os, context, false).write_node(context.ast_root.get());
+}
+
+void ASTSerializer::serialize_interface(std::ostream& os,
+                                        const ModuleContext& context) {
+  ASTWriter(os, context, true).write_node(context.ast_root.get());
+}
+
+std::unique_ptr<ProgramNode> ASTSerializer::deserialize(std::istream& is,
+                                                        ModuleContext& context,
+                                                        uint32_t file_id) {
+  Profiling::AllocationScope allocation_scope(Profiling::AllocationTag::AST);
+  std::unique_ptr<ASTNode> root = ASTReader(is, context, file_id).read_node();
+
+  if (!root || root->get_kind() != ASTNode::Kind::PROGRAM) {
+    throw ASTDeserializationException();
+  }
+
+  return std::unique_ptr<ProgramNode>(
+      static_cast<ProgramNode*>(root.release()));
+}
+}  // namespace Front
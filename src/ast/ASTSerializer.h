@@ -0,0 +1,38 @@
+#pragma once
+
+#include <iostream>
+#include <memory>
+
+#include "ast/Nodes.h"
+#include "compilation/ModuleContext.h"
+#include "utils/Serializer.h"
+
+namespace Front {
+// Compact binary representation of the AST right after parsing.
+// Numbers are written as varints, strings are written once and then referenced
+// by index, source ranges are stored without file_id (it is different on
+// each run, so it is passed to deserialize instead). Fields that are filled
+// by SemanticAnalyzer (types, value categories, etc.) are not preserved.
+class ASTSerializer : public Serializer {
+ public:
+  static void serialize(std::ostream& os, const ModuleContext& context);
+
+  // writes only what importers need: function bodies and variable
+  // initializers are dropped, functions are marked extern, functions and
+  // variables that are neither exported nor inside exported namespace are
+  // skipped. Source ranges are not preserved.
+  static void serialize_interface(std::ostream& os,
+                                  const ModuleContext& context);
+
+  // strings are added into context's StringPool, returned tree is not stored
+  // in context. Throws ASTDeserializationException on malformed input.
+  static std::unique_ptr<ProgramNode> deserialize(std::istream& is,
+                                                  ModuleContext& context,
+                                                  uint32_t file_id);
+};
+
+struct ASTDeserializationException : std::runtime_error {
+  ASTDeserializationException()
+      : std::runtime_error("Malformed serialized AST.") {}
+};
+}  // namespace Front
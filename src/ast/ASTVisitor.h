@@ -34,41 +34,51 @@ class ASTVisitor {
   template <typename T>
   using wrap_const = std::conditional_t<Config::is_const(), const T, T>;
 
+  // Hook is overridden when Child declares its own member with this name: then
+  // pointer to it has different type from the pointer to the default one.
+  // Calls to hooks that are not overridden are skipped at compile time, so
+  // visitors pay only for hooks they actually use.
+#define VISITOR_OVERRIDES(hook) \
+  (!std::is_same_v<decltype(&Child::hook), decltype(&ASTVisitor::hook)>)
+
+#define VISITOR_CALL_HOOK(hook, node)      \
+  if constexpr (VISITOR_OVERRIDES(hook)) { \
+    if (!child().hook(node)) {             \
+      return false;                        \
+    }                                      \
+  }
+
  public:
   enum class NodeTraverseType { CONTINUE, STOP, SKIP_NODE };
 
   ASTVisitor() = default;
 
   bool traverse(wrap_const<ASTNode>& node) {
-    auto traverse_type = child().before_traverse(node);
-    if (traverse_type != NodeTraverseType::CONTINUE) {
-      return traverse_type == NodeTraverseType::SKIP_NODE;
+    if constexpr (VISITOR_OVERRIDES(before_traverse)) {
+      auto traverse_type = child().before_traverse(node);
+      if (traverse_type != NodeTraverseType::CONTINUE) {
+        return traverse_type == NodeTraverseType::SKIP_NODE;
+      }
     }
 
     switch (node.get_kind()) {
-#define NODE(kind, type, snake_case)                                           \
-  case ASTNode::Kind::kind:                                                    \
-    if (!child().before_##snake_case(static_cast<wrap_const<type>&>(node))) {  \
-      return false;                                                            \
-    }                                                                          \
-    if constexpr (Config::order() == Order::PREORDER) {                        \
-      if (!child().visit_##snake_case(static_cast<wrap_const<type>&>(node))) { \
-        return false;                                                          \
-      }                                                                        \
-    }                                                                          \
-    if (!child().traverse_##snake_case(                                        \
-            static_cast<wrap_const<type>&>(node))) {                           \
-      return false;                                                            \
-    }                                                                          \
-    if constexpr (Config::order() == Order::POSTORDER) {                       \
-      if (!child().visit_##snake_case(static_cast<wrap_const<type>&>(node))) { \
-        return false;                                                          \
-      }                                                                        \
-    }                                                                          \
-    if (!child().after_##snake_case(static_cast<wrap_const<type>&>(node))) {   \
-      return false;                                                            \
-    }                                                                          \
-    break;
+#define NODE(kind, type, snake_case)                         \
+  case ASTNode::Kind::kind: {                                \
+    auto& typed_node = static_cast<wrap_const<type>&>(node); \
+                                                             \
+    VISITOR_CALL_HOOK(before_##snake_case, typed_node);      \
+    if constexpr (Config::order() == Order::PREORDER) {      \
+      VISITOR_CALL_HOOK(visit_##snake_case, typed_node);     \
+    }                                                        \
+    if (!child().traverse_##snake_case(typed_node)) {        \
+      return false;                                          \
+    }                                                        \
+    if constexpr (Config::order() == Order::POSTORDER) {     \
+      VISITOR_CALL_HOOK(visit_##snake_case, typed_node);     \
+    }                                                        \
+    VISITOR_CALL_HOOK(after_##snake_case, typed_node);       \
+    break;                                                   \
+  }
 
 #include "ast/NodesList.h"
 
@@ -77,10 +87,7 @@ class ASTVisitor {
         unreachable("All nodes types are enumerated above.");
     }
 
-    if (!child().after_traverse(node)) {
-      return false;
-    }
-
+    VISITOR_CALL_HOOK(after_traverse, node);
     return true;
   }
 
@@ -297,5 +304,7 @@ class ASTVisitor {
 #include "ast/NodesList.h"
 
 #undef NODE
+#undef VISITOR_CALL_HOOK
+#undef VISITOR_OVERRIDES
 };
 }  // namespace Front
@@ -1,5 +1,6 @@
 #pragma once
 #include <bitset>
+#include <limits>
 #include <memory>
 #include <ranges>
 #include <vector>
@@ -13,7 +14,7 @@
 
 // Here all AST Nodes are defined. To add new node:
 // 1. Create class and inherit it from ASTNode
-// 2. Add new ASTNode::Kind
+// 2. Add new ASTNode::Kind and pass it to the base class constructor
 // 3. Register node in NodesList.h
 // 4. Add traverse_* method in ASTVisitor
 // 5. Add visit_* method in ASTPrinter
@@ -63,14 +64,24 @@ struct ASTNode {
 
   SourceRange source_range;
 
-  explicit ASTNode(SourceRange source_range) : source_range(source_range) {}
+ private:
+  // kind is stored in the node itself, so checking it doesn't require a
+  // virtual call and fits into padding after source_range
+  uint8_t kind_;
+
+  static_assert(Kind::count < std::numeric_limits<uint8_t>::max());
+
+ public:
+  ASTNode(Kind kind, SourceRange source_range)
+      : source_range(source_range),
+        kind_(static_cast<uint8_t>(static_cast<size_t>(kind))) {}
 
   SourceLocation source_begin() const { return source_range.begin; }
   SourceLocation source_end() const { return source_range.end; }
 
   virtual ~ASTNode() = default;
 
-  virtual Kind get_kind() const = 0;
+  Kind get_kind() const { return Kind(static_cast<size_t>(kind_)); }
 };
 
 struct Statement : ASTNode {
@@ -80,24 +91,23 @@ struct Declaration : ASTNode {
   StringId name;
   DeclarationSpecifiers specifiers;
 
-  Declaration(SourceRange source_range, StringId name)
-      : ASTNode(source_range), name(name) {}
+  Declaration(Kind kind, SourceRange source_range, StringId name)
+      : ASTNode(kind, source_range), name(name) {}
 };
 
 // types
 struct TypeNode : ASTNode {
   Type* value{nullptr};
 
-  TypeNode(SourceRange source_range) : ASTNode(source_range) {}
+  TypeNode(Kind kind, SourceRange source_range)
+      : ASTNode(kind, source_range) {}
 };
 
 struct PointerTypeNode final : TypeNode {
   std::unique_ptr<TypeNode> child;
 
   PointerTypeNode(SourceRange source_range, std::unique_ptr<TypeNode> child)
-      : TypeNode(source_range), child(std::move(child)) {}
-
-  Kind get_kind() const override { return Kind::POINTER_TYPE; }
+      : TypeNode(Kind::POINTER_TYPE, source_range), child(std::move(child)) {}
 };
 struct PrimitiveTypeNode final : TypeNode {
   // These fields are only relevant before SemanticAnalyzer pass
@@ -106,27 +116,26 @@ struct PrimitiveTypeNode final : TypeNode {
   size_t width;
 
   PrimitiveTypeNode(SourceRange source_range, Type::Kind kind, size_t width)
-      : TypeNode(source_range), kind(kind), width(width) {}
-
-  Kind get_kind() const override { return Kind::PRIMITIVE_TYPE; }
+      : TypeNode(Kind::PRIMITIVE_TYPE, source_range),
+        kind(kind),
+        width(width) {}
 };
 struct TupleTypeNode final : TypeNode {
   std::vector<std::unique_ptr<TypeNode>> elements;
 
   TupleTypeNode(SourceRange source_range,
                 std::vector<std::unique_ptr<TypeNode>> elements)
-      : TypeNode(source_range), elements(std::move(elements)) {}
-  explicit TupleTypeNode(SourceRange source_range) : TypeNode(source_range) {}
-
-  Kind get_kind() const override { return Kind::TUPLE_TYPE; }
+      : TypeNode(Kind::TUPLE_TYPE, source_range),
+        elements(std::move(elements)) {}
+  explicit TupleTypeNode(SourceRange source_range)
+      : TypeNode(Kind::TUPLE_TYPE, source_range) {}
 };
 struct UserDefinedTypeNode final : TypeNode {
   QualifiedId name;
 
   UserDefinedTypeNode(SourceRange source_range, QualifiedId name)
-      : TypeNode(source_range), name(std::move(name)) {}
-
-  Kind get_kind() const override { return Kind::USER_DEFINED_TYPE; }
+      : TypeNode(Kind::USER_DEFINED_TYPE, source_range),
+        name(std::move(name)) {}
 };
 
 struct TypeAliasDecl final : Declaration {
@@ -134,18 +143,16 @@ struct TypeAliasDecl final : Declaration {
 
   TypeAliasDecl(SourceRange source_range, StringId alias,
                 std::unique_ptr<TypeNode> original)
-      : Declaration(source_range, alias), original(std::move(original)) {}
-
-  Kind get_kind() const override { return Kind::TYPE_ALIAS_DECL; }
+      : Declaration(Kind::TYPE_ALIAS_DECL, source_range, alias),
+        original(std::move(original)) {}
 };
 struct ClassDecl final : Declaration {
   std::vector<std::unique_ptr<Declaration>> body;
 
   ClassDecl(SourceRange source_range, StringId name,
             std::vector<std::unique_ptr<Declaration>> body)
-      : Declaration(source_range, name), body(std::move(body)) {}
-
-  Kind get_kind() const override { return Kind::CLASS_DECL; }
+      : Declaration(Kind::CLASS_DECL, source_range, name),
+        body(std::move(body)) {}
 };
 
 enum class ValueCategory {
@@ -156,8 +163,9 @@ enum class ValueCategory {
 };
 
 struct Expression : ASTNode {
-  Type* type{nullptr};
+  // value_category goes first to occupy padding after ASTNode::kind_
   ValueCategory value_category{ValueCategory::UNKNOWN};
+  Type* type{nullptr};
 
   using ASTNode::ASTNode;
 };
@@ -165,56 +173,46 @@ struct Expression : ASTNode {
 struct CompoundStmt : Statement {
   std::vector<std::unique_ptr<Statement>> statements;
 
-  CompoundStmt(SourceRange source_range) : Statement(source_range) {}
+  CompoundStmt(SourceRange source_range)
+      : Statement(Kind::COMPOUND_STMT, source_range) {}
 
   void add_item(std::unique_ptr<Statement> node) {
     statements.push_back(std::move(node));
   }
-
-  Kind get_kind() const override { return Kind::COMPOUND_STMT; }
 };
 
 struct ReturnStmt : Statement {
   std::unique_ptr<Expression> value;
 
   ReturnStmt(SourceRange source_range, std::unique_ptr<Expression> value)
-      : Statement(source_range), value(std::move(value)) {}
-
-  Kind get_kind() const override { return Kind::RETURN_STMT; }
+      : Statement(Kind::RETURN_STMT, source_range), value(std::move(value)) {}
 };
 
 struct IntegerLiteral : Expression {
   int64_t value;
 
   IntegerLiteral(SourceRange source_range, int64_t value)
-      : Expression(source_range), value(value) {}
-
-  Kind get_kind() const override { return Kind::INTEGER_LITERAL_EXPR; }
+      : Expression(Kind::INTEGER_LITERAL_EXPR, source_range), value(value) {}
 };
 
 struct BoolLiteral : Expression {
   bool value;
 
   BoolLiteral(SourceRange source_range, bool value)
-      : Expression(source_range), value(value) {}
-
-  Kind get_kind() const override { return Kind::BOOL_LITERAL_EXPR; }
+      : Expression(Kind::BOOL_LITERAL_EXPR, source_range), value(value) {}
 };
 
 struct StringLiteral : Expression {
   StringId id;
   StringLiteral(SourceRange source_range, StringId id)
-      : Expression(source_range), id(id) {}
-
-  Kind get_kind() const override { return Kind::STRING_LITERAL_EXPR; }
+      : Expression(Kind::STRING_LITERAL_EXPR, source_range), id(id) {}
 };
 
 struct IdExpr : Expression {
   QualifiedId id;
 
   IdExpr(SourceRange source_range, QualifiedId id)
-      : Expression(source_range), id(std::move(id)) {}
-  Kind get_kind() const override { return Kind::ID_EXPR; }
+      : Expression(Kind::ID_EXPR, source_range), id(std::move(id)) {}
 };
 
 struct MemberExpr : Expression {
@@ -224,11 +222,9 @@ struct MemberExpr : Expression {
 
   MemberExpr(SourceRange source_range, std::unique_ptr<Expression> left,
              QualifiedId member)
-      : Expression(source_range),
+      : Expression(Kind::MEMBER_EXPR, source_range),
         left(std::move(left)),
         member(std::move(member)) {}
-
-  Kind get_kind() const override { return Kind::MEMBER_EXPR; }
 };
 struct TupleIndexExpr : Expression {
   std::unique_ptr<Expression> left;
@@ -236,9 +232,9 @@ struct TupleIndexExpr : Expression {
 
   TupleIndexExpr(SourceRange source_range, std::unique_ptr<Expression> left,
                  size_t index)
-      : Expression(source_range), left(std::move(left)), index(index) {}
-
-  Kind get_kind() const override { return Kind::TUPLE_INDEX_EXPR; }
+      : Expression(Kind::TUPLE_INDEX_EXPR, source_range),
+        left(std::move(left)),
+        index(index) {}
 };
 
 struct TupleExpr : Expression {
@@ -246,16 +242,13 @@ struct TupleExpr : Expression {
 
   TupleExpr(SourceRange source_range,
             std::vector<std::unique_ptr<Expression>> elements)
-      : Expression(source_range), elements(std::move(elements)) {}
-
-  Kind get_kind() const override { return Kind::TUPLE_EXPR; }
+      : Expression(Kind::TUPLE_EXPR, source_range),
+        elements(std::move(elements)) {}
 };
 
 struct ImportDecl : Declaration {
   ImportDecl(SourceRange source_range, StringId module_name)
-      : Declaration(source_range, module_name) {}
-
-  Kind get_kind() const override { return Kind::IMPORT_DECL; }
+      : Declaration(Kind::IMPORT_DECL, source_range, module_name) {}
 };
 
 struct BinaryOperator : Expression {
@@ -281,7 +274,7 @@ struct BinaryOperator : Expression {
   BinaryOperator(SourceRange source_range, OpType op_type,
                  std::unique_ptr<Expression> left,
                  std::unique_ptr<Expression> right)
-      : Expression(source_range),
+      : Expression(Kind::BINARY_OPERATOR_EXPR, source_range),
         op_type(op_type),
         left(std::move(left)),
         right(std::move(right)) {}
@@ -326,8 +319,6 @@ struct BinaryOperator : Expression {
         unreachable("All operators are presented above.");
     }
   }
-
-  Kind get_kind() const override { return Kind::BINARY_OPERATOR_EXPR; }
 };
 
 struct UnaryOperator : Expression {
@@ -344,7 +335,9 @@ struct UnaryOperator : Expression {
 
   UnaryOperator(SourceRange source_range, OpType op_type,
                 std::unique_ptr<Expression> value)
-      : Expression(source_range), op_type(op_type), value(std::move(value)) {}
+      : Expression(Kind::UNARY_OPERATOR_EXPR, source_range),
+        op_type(op_type),
+        value(std::move(value)) {}
 
   std::string_view get_string_representation() const {
     switch (op_type) {
@@ -362,8 +355,6 @@ struct UnaryOperator : Expression {
         unreachable("All operators are presented above.");
     }
   }
-
-  Kind get_kind() const override { return Kind::UNARY_OPERATOR_EXPR; }
 };
 
 struct CallExpr : Expression {
@@ -372,11 +363,9 @@ struct CallExpr : Expression {
 
   CallExpr(SourceRange source_range, std::unique_ptr<Expression> callee,
            std::vector<std::unique_ptr<Expression>> arguments)
-      : Expression(source_range),
+      : Expression(Kind::CALL_EXPR, source_range),
         callee(std::move(callee)),
         arguments(std::move(arguments)) {}
-
-  Kind get_kind() const override { return Kind::CALL_EXPR; }
 };
 
 struct VariableDecl final : Declaration {
@@ -386,11 +375,9 @@ struct VariableDecl final : Declaration {
   VariableDecl(SourceRange source_range, StringId name,
                std::unique_ptr<TypeNode> type,
                std::unique_ptr<Expression> initializer)
-      : Declaration(source_range, name),
+      : Declaration(Kind::VARIABLE_DECL, source_range, name),
         type(std::move(type)),
         initializer(std::move(initializer)) {}
-
-  Kind get_kind() const override { return Kind::VARIABLE_DECL; }
 };
 
 struct AssignmentStmt : Statement {
@@ -399,11 +386,9 @@ struct AssignmentStmt : Statement {
 
   AssignmentStmt(SourceRange source_range, std::unique_ptr<Expression> left,
                  std::unique_ptr<Expression> right)
-      : Statement(source_range),
+      : Statement(Kind::ASSIGNMENT_STMT, source_range),
         left(std::move(left)),
         right(std::move(right)) {}
-
-  Kind get_kind() const override { return Kind::ASSIGNMENT_STMT; }
 };
 
 struct FunctionDecl final : Declaration {
@@ -415,21 +400,18 @@ struct FunctionDecl final : Declaration {
                std::vector<std::unique_ptr<VariableDecl>> parameters,
                std::unique_ptr<TypeNode> return_type,
                std::unique_ptr<CompoundStmt> body)
-      : Declaration(source_range, name),
+      : Declaration(Kind::FUNCTION_DECL, source_range, name),
         parameters(std::move(parameters)),
         return_type(std::move(return_type)),
         body(std::move(body)) {}
-
-  Kind get_kind() const override { return Kind::FUNCTION_DECL; }
 };
 
 struct ProgramNode : ASTNode {
   std::vector<std::unique_ptr<ImportDecl>> imports;
   std::vector<std::unique_ptr<Declaration>> declarations;
 
-  explicit ProgramNode(SourceRange source_range) : ASTNode(source_range) {}
-
-  Kind get_kind() const override { return Kind::PROGRAM; }
+  explicit ProgramNode(SourceRange source_range)
+      : ASTNode(Kind::PROGRAM, source_range) {}
 };
 
 struct DeclarationStmt : Statement {
@@ -437,9 +419,8 @@ struct DeclarationStmt : Statement {
 
   DeclarationStmt(SourceRange source_range,
                   std::unique_ptr<Declaration> declaration)
-      : Statement(source_range), value(std::move(declaration)) {}
-
-  Kind get_kind() const override { return Kind::DECLARATION_STMT; }
+      : Statement(Kind::DECLARATION_STMT, source_range),
+        value(std::move(declaration)) {}
 };
 
 struct ExpressionStmt : Statement {
@@ -447,9 +428,8 @@ struct ExpressionStmt : Statement {
 
   ExpressionStmt(SourceRange source_range,
                  std::unique_ptr<Expression> expression)
-      : Statement(source_range), value(std::move(expression)) {}
-
-  Kind get_kind() const override { return Kind::EXPRESSION_STMT; }
+      : Statement(Kind::EXPRESSION_STMT, source_range),
+        value(std::move(expression)) {}
 };
 
 struct NamespaceDecl final : Declaration {
@@ -457,9 +437,8 @@ struct NamespaceDecl final : Declaration {
 
   NamespaceDecl(SourceRange source_range, StringId name,
                 std::vector<std::unique_ptr<Declaration>> body)
-      : Declaration(source_range, name), body(std::move(body)) {}
-
-  Kind get_kind() const override { return Kind::NAMESPACE_DECL; }
+      : Declaration(Kind::NAMESPACE_DECL, source_range, name),
+        body(std::move(body)) {}
 };
 
 struct WhileStmt : Statement {
@@ -468,11 +447,9 @@ struct WhileStmt : Statement {
 
   WhileStmt(SourceRange source_range, std::unique_ptr<Expression> condition,
             std::unique_ptr<CompoundStmt> body)
-      : Statement(source_range),
+      : Statement(Kind::WHILE_STMT, source_range),
         condition(std::move(condition)),
         body(std::move(body)) {}
-
-  Kind get_kind() const override { return Kind::WHILE_STMT; }
 };
 
 struct IfStmt : Statement {
@@ -483,22 +460,20 @@ struct IfStmt : Statement {
   IfStmt(SourceRange source_range, std::unique_ptr<Expression> condition,
          std::unique_ptr<CompoundStmt> true_branch,
          std::unique_ptr<CompoundStmt> false_branch)
-      : Statement(source_range),
+      : Statement(Kind::IF_STMT, source_range),
         condition(std::move(condition)),
         true_branch(std::move(true_branch)),
         false_branch(std::move(false_branch)) {}
-
-  Kind get_kind() const override { return Kind::IF_STMT; }
 };
 
 struct ContinueStmt : Statement {
-  explicit ContinueStmt(SourceRange source_range) : Statement(source_range) {}
-  Kind get_kind() const override { return Kind::CONTINUE_STMT; }
+  explicit ContinueStmt(SourceRange source_range)
+      : Statement(Kind::CONTINUE_STMT, source_range) {}
 };
 
 struct BreakStmt : Statement {
-  explicit BreakStmt(SourceRange source_range) : Statement(source_range) {}
-  Kind get_kind() const override { return Kind::BREAK_STMT; }
+  explicit BreakStmt(SourceRange source_range)
+      : Statement(Kind::BREAK_STMT, source_range) {}
 };
 
 // implicit nodes (added by SemanticAnalyzer)
@@ -507,11 +482,9 @@ struct ImplicitLvalueToRvalueConversionExpr : Expression {
 
   ImplicitLvalueToRvalueConversionExpr(SourceRange source_range,
                                        std::unique_ptr<Expression> value)
-      : Expression(source_range), value(std::move(value)) {}
-
-  Kind get_kind() const override {
-    return Kind::IMPLICIT_LVALUE_TO_RVALUE_CONVERSION_EXPR;
-  }
+      : Expression(Kind::IMPLICIT_LVALUE_TO_RVALUE_CONVERSION_EXPR,
+                   source_range),
+        value(std::move(value)) {}
 };
 
 // TODO: this node is similar to copy-constructor call
@@ -520,20 +493,18 @@ struct ImplicitTupleCopyExpr : Expression {
 
   ImplicitTupleCopyExpr(SourceRange source_range,
                         std::unique_ptr<Expression> value)
-      : Expression(source_range), value(std::move(value)) {}
-
-  Kind get_kind() const override { return Kind::IMPLICIT_TUPLE_COPY_EXPR; }
+      : Expression(Kind::IMPLICIT_TUPLE_COPY_EXPR, source_range),
+        value(std::move(value)) {}
 };
 
 // ASTNodes that follow this line are supplementary.
 // They are used only in Parser. They must not be presented in AST after parsing
 
 struct SupplementaryNode : ASTNode {
-  using ASTNode::ASTNode;
-
-  Kind get_kind() const override {
-    unreachable("Token node doesn't appear anywhere except ASTBuildContext.");
-  }
+  // supplementary nodes have no kind of their own: Kind::count is out of
+  // enum range, so any switch over it ends up in unreachable
+  explicit SupplementaryNode(SourceRange source_range)
+      : ASTNode(Kind(Kind::count), source_range) {}
 };
 
 struct TokenNode final : SupplementaryNode {
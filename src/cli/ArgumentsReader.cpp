@@ -2,18 +2,40 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <argparse/argparse.hpp>
 #include <filesystem>
 #include <regex>
+#include <thread>
 
 #include "Exceptions.h"
+#include "profiling/AllocationProfiler.h"
 
 namespace fs = std::filesystem;
 
 namespace Cli {
+namespace {
+// argparse doesn't accept values joined with short options, so `-O2` is
+// split into `-O 2`
+std::vector<std::string> split_optimization_level(
+    const std::vector<std::string>& arguments) {
+  std::vector<std::string> result;
+
+  for (const auto& argument : arguments) {
+    if (argument.starts_with("-O") && argument.size() > 2) {
+      result.emplace_back("-O");
+      result.push_back(argument.substr(2));
+    } else {
+      result.push_back(argument);
+    }
+  }
+
+  return result;
+}
+}  // namespace
 
 SourcesList ArgumentsReader::parse_source_paths(
-    std::vector<std::string> sources) {
+    std::vector<std::string> sources, const fs::path& working_directory) {
   SourcesList result;
   auto add_source = [&result](const std::string& name, const fs::path& path) {
     auto [_, was_emplaced] = result.emplace(name, path);
@@ -35,7 +57,8 @@ SourcesList ArgumentsReader::parse_source_paths(
         throw std::runtime_error("Include name must be non-empty.");
       }
 
-      fs::path path = include.substr(index + 1, include.size() - index);
+      std::string filepath = include.substr(index + 1, include.size() - index);
+      fs::path path = resolve(working_directory, filepath);
 
       if (!fs::is_regular_file(path)) {
         throw std::runtime_error(fmt::format(
@@ -51,10 +74,11 @@ SourcesList ArgumentsReader::parse_source_paths(
       // for example file with relative path from given directory root
       // foo/baz/prog.rec will be available with #include "foo.baz.prog"
 
-      fs::path path = include;
+      fs::path path = resolve(working_directory, include);
 
       if (is_regular_file(path)) {
-        fs::path path_copy = path;
+        // name is built from path as it was written
+        fs::path path_copy = include;
         path_copy.replace_extension();
 
         auto include_name = std::regex_replace(std::string{path_copy},
@@ -87,17 +111,37 @@ SourcesList ArgumentsReader::parse_source_paths(
   return result;
 }
 
-std::filesystem::path ArgumentsReader::parse_output(const std::string& output) {
-  fs::path output_path = output;
+std::filesystem::path ArgumentsReader::parse_output(
+    const std::string& output, const fs::path& working_directory) {
+  fs::path output_path = resolve(working_directory, output);
 
   // output must be directory or path
-  if (fs::is_directory(output)) {
+  if (fs::is_directory(output_path)) {
     output_path /= kDefaultOutputName;
   }
 
   return output_path;
 }
 
+fs::path ArgumentsReader::resolve(const fs::path& working_directory,
+                                  const fs::path& path) {
+  if (path.empty()) {
+    return path;
+  }
+
+  // absolute path is returned as is
+  return working_directory / path;
+}
+
+size_t ArgumentsReader::parse_jobs(size_t jobs) {
+  if (jobs != 0) {
+    return jobs;
+  }
+
+  // hardware_concurrency can return 0 when it is not computable
+  return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
 Front::EmitType ArgumentsReader::get_emit_type(std::string_view name) {
   if (name == "ir") {
     return Front::EmitType::IR;
@@ -105,12 +149,79 @@ Front::EmitType ArgumentsReader::get_emit_type(std::string_view name) {
   if (name == "ast") {
     return Front::EmitType::AST;
   }
+  if (name == "bc") {
+    return Front::EmitType::BC;
+  }
+  if (name == "asm") {
+    return Front::EmitType::ASM;
+  }
+  if (name == "obj") {
+    return Front::EmitType::OBJ;
+  }
   throw std::runtime_error("unknown compiler emit type.");
 }
 
+Front::OptimizationLevel ArgumentsReader::get_optimization_level(
+    std::string_view name) {
+  if (name == "0") {
+    return Front::OptimizationLevel::O0;
+  }
+  if (name == "1") {
+    return Front::OptimizationLevel::O1;
+  }
+  if (name == "2") {
+    return Front::OptimizationLevel::O2;
+  }
+  if (name == "3") {
+    return Front::OptimizationLevel::O3;
+  }
+  if (name == "s") {
+    return Front::OptimizationLevel::Os;
+  }
+  throw std::runtime_error("unknown optimization level.");
+}
+
+DiagnosticsFormat ArgumentsReader::get_diagnostics_format(
+    std::string_view name) {
+  if (name == "text") {
+    return DiagnosticsFormat::TEXT;
+  }
+  if (name == "json") {
+    return DiagnosticsFormat::JSON;
+  }
+  throw std::runtime_error("unknown diagnostics format.");
+}
+
 Front::TeaFrontendConfiguration ArgumentsReader::read(int argc, char* argv[]) {
-  argparse::ArgumentParser parser("compiler");
+  return read(std::vector<std::string>(argv, argv + argc));
+}
+
+Front::TeaFrontendConfiguration ArgumentsReader::read(
+    const std::vector<std::string>& arguments) {
+  return read(arguments, {}, argparse::default_arguments::all);
+}
+
+Front::TeaFrontendConfiguration ArgumentsReader::read_remote(
+    const std::vector<std::string>& arguments,
+    const fs::path& working_directory) {
+  return read(arguments, working_directory, argparse::default_arguments::none);
+}
+
+Front::TeaFrontendConfiguration ArgumentsReader::read(
+    const std::vector<std::string>& arguments,
+    const fs::path& working_directory,
+    argparse::default_arguments default_arguments) {
+  argparse::ArgumentParser parser("compiler", "1.0", default_arguments);
   parser.add_description("Compiler for TeaLang ☕️");
+  parser.add_epilog(
+      "`run <arguments>` compiles sources with JIT and executes their main "
+      "function, its result is the exit code. `--batch <manifest>` compiles "
+      "independent units in one process, each line of manifest holds "
+      "arguments of one unit. Compile server keeps "
+      "loaded tables and compiled modules between compilations. Start it "
+      "with `--server <socket>` and pass `--connect <socket>` before usual "
+      "arguments to compile with it, `--connect <socket> --shutdown` stops "
+      "the server.");
 
   parser.add_argument("sources")
       .nargs(argparse::nargs_pattern::at_least_one)
@@ -125,21 +236,166 @@ Front::TeaFrontendConfiguration ArgumentsReader::read(int argc, char* argv[]) {
       .help("output file (stdout by default)");
 
   parser.add_argument("--emit")
-      .choices("ir", "ast")
+      .choices("ir", "ast", "bc", "asm", "obj")
       .default_value("ir")
-      .help("compiler output type: `ir` or `ast`");
+      .help(
+          "compiler output type: `ir`, `ast`, `bc` (bitcode), `asm` "
+          "(assembly) or `obj` (object file)");
+
+  parser.add_argument("--ast-cache")
+      .default_value("")
+      .help(
+          "directory where parsed sources are cached, unchanged files are "
+          "not parsed again (disabled by default)");
+
+  parser.add_argument("--module-cache")
+      .default_value("")
+      .help(
+          "directory where compiled modules are cached, module is recompiled "
+          "only when its source or interfaces of its imports change "
+          "(disabled by default)");
+
+  parser.add_argument("-O")
+      .choices("0", "1", "2", "3", "s")
+      .default_value("0")
+      .help(
+          "optimization level: -O0 (default), -O1, -O2, -O3 or -Os to "
+          "optimize for size");
+
+  parser.add_argument("-march")
+      .default_value("")
+      .help("target architecture, like x86-64 or aarch64 (host by default)");
+
+  parser.add_argument("-mcpu")
+      .default_value("")
+      .help("target CPU, `native` for CPU of the host (generic by default)");
+
+  parser.add_argument("-mattr")
+      .default_value("")
+      .help("target features to enable or disable, like `+avx2,-sse4.1`");
+
+  parser.add_argument("--thin-lto")
+      .default_value(false)
+      .implicit_value(true)
+      .help(
+          "don't link modules into one, optimize them in parallel with ThinLTO "
+          "and write <module>.o (or .s) of each one next to the output, "
+          "requires --emit obj or asm");
+
+  parser.add_argument("--load")
+      .append()
+      .default_value(std::vector<std::string>{})
+      .help(
+          "shared library where extern functions are looked up by `run`, can "
+          "be repeated");
+
+  parser.add_argument("-j", "--jobs")
+      .default_value(size_t{1})
+      .scan<'u', size_t>()
+      .help(
+          "number of modules that are compiled in parallel (0 to use all "
+          "hardware threads)");
+
+  parser.add_argument("--emit-interface")
+      .default_value(false)
+      .implicit_value(true)
+      .help(
+          "write precompiled interface <name>.tmi of each module next to the "
+          "output, importers can pass it instead of module source, requires "
+          "an output file");
+
+  parser.add_argument("--time-report")
+      .default_value(false)
+      .implicit_value(true)
+      .help(
+          "print wall time, CPU time and peak memory growth of each "
+          "compilation phase and module to stderr");
+
+  parser.add_argument("--time-passes")
+      .default_value(false)
+      .implicit_value(true)
+      .help("print time of each optimization pass to stderr");
+
+  parser.add_argument("--mem-report")
+      .default_value(false)
+      .implicit_value(true)
+      .help(
+          "print number and size of allocations made by each frontend "
+          "subsystem to stderr (requires build with "
+          "TEALANG_ALLOCATION_PROFILING)");
+
+  parser.add_argument("--trace-out")
+      .default_value("")
+      .help(
+          "write trace of compilation phases in Chrome trace-event format, "
+          "it can be opened in ui.perfetto.dev (disabled by default)");
+
+  parser.add_argument("--max-errors")
+      .default_value(size_t{20})
+      .scan<'u', size_t>()
+      .help(
+          "stop compilation after this number of errors, 20 by default (0 "
+          "means no limit)");
+
+  parser.add_argument("--diagnostics-format")
+      .choices("text", "json")
+      .default_value("text")
+      .help(
+          "format of errors: `text` or `json` (one JSON object per line, for "
+          "tools)");
 
   try {
-    parser.parse_args(argc, argv);
+    parser.parse_args(split_optimization_level(arguments));
   } catch (const std::exception& err) {
     throw ArgumentsParseException(err.what());
   }
 
+  if (parser.get<bool>("mem-report") &&
+      !Profiling::kIsAllocationProfilingEnabled) {
+    throw ArgumentsParseException(
+        "--mem-report requires compiler built with "
+        "TEALANG_ALLOCATION_PROFILING cmake option.");
+  }
+
+  if (parser.get<bool>("thin-lto") &&
+      (parser.get("output").empty() ||
+       (parser.get("emit") != "obj" && parser.get("emit") != "asm"))) {
+    throw ArgumentsParseException(
+        "--thin-lto requires --emit obj or asm and an output file.");
+  }
+
+  // interfaces are written next to the output, stdout has no directory
+  if (parser.get<bool>("emit-interface") && parser.get("output").empty()) {
+    throw ArgumentsParseException("--emit-interface requires an output file.");
+  }
+
   Front::TeaFrontendConfiguration result;
-  result.sources =
-      parse_source_paths(parser.get<std::vector<std::string>>("sources"));
+  result.sources = parse_source_paths(
+      parser.get<std::vector<std::string>>("sources"), working_directory);
   result.emit_type = get_emit_type(parser.get<std::string>("emit"));
-  result.output_file = parse_output(parser.get("output"));
+  result.output_file = parse_output(parser.get("output"), working_directory);
+  result.ast_cache_directory =
+      resolve(working_directory, parser.get("ast-cache"));
+  result.module_cache_directory =
+      resolve(working_directory, parser.get("module-cache"));
+  result.optimization_level =
+      get_optimization_level(parser.get<std::string>("-O"));
+  result.thin_lto = parser.get<bool>("thin-lto");
+  result.target = {.arch = parser.get("-march"),
+                   .cpu = parser.get("-mcpu"),
+                   .features = parser.get("-mattr")};
+  for (const auto& library : parser.get<std::vector<std::string>>("load")) {
+    result.libraries.push_back(resolve(working_directory, library));
+  }
+  result.jobs = parse_jobs(parser.get<size_t>("jobs"));
+  result.emit_interfaces = parser.get<bool>("emit-interface");
+  result.time_report = parser.get<bool>("time-report");
+  result.time_passes = parser.get<bool>("time-passes");
+  result.mem_report = parser.get<bool>("mem-report");
+  result.trace_file = resolve(working_directory, parser.get("trace-out"));
+  result.max_errors = parser.get<size_t>("max-errors");
+  result.diagnostics_format =
+      get_diagnostics_format(parser.get<std::string>("diagnostics-format"));
 
   return result;
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <argparse/argparse.hpp>
 #include <array>
 #include <filesystem>
 #include <string>
@@ -16,13 +17,44 @@ class ArgumentsReader {
   constexpr static auto kDefaultOutputName = "out";
   constexpr static auto kSourceNamePathDelimiter = ":";
 
-  static SourcesList parse_source_paths(std::vector<std::string> sources);
+  static SourcesList parse_source_paths(
+      std::vector<std::string> sources,
+      const std::filesystem::path& working_directory);
 
-  static std::filesystem::path parse_output(const std::string& output);
+  static std::filesystem::path parse_output(
+      const std::string& output,
+      const std::filesystem::path& working_directory);
+
+  // relative paths are resolved against given directory instead of current
+  // one, empty path stays empty
+  static std::filesystem::path resolve(
+      const std::filesystem::path& working_directory,
+      const std::filesystem::path& path);
+
+  static size_t parse_jobs(size_t jobs);
 
   static Front::EmitType get_emit_type(std::string_view name);
 
+  static Front::OptimizationLevel get_optimization_level(
+      std::string_view name);
+
+  static DiagnosticsFormat get_diagnostics_format(std::string_view name);
+
+  static Front::TeaFrontendConfiguration read(
+      const std::vector<std::string>& arguments,
+      const std::filesystem::path& working_directory,
+      argparse::default_arguments default_arguments);
+
  public:
   static Front::TeaFrontendConfiguration read(int argc, char* argv[]);
+  static Front::TeaFrontendConfiguration read(
+      const std::vector<std::string>& arguments);
+
+  // compile server reads arguments of clients, which have their own working
+  // directories, first argument is a program name. Server must not exit, so
+  // --help and --version are not accepted here
+  static Front::TeaFrontendConfiguration read_remote(
+      const std::vector<std::string>& arguments,
+      const std::filesystem::path& working_directory);
 };
 }  // namespace Cli
@@ -0,0 +1,89 @@
+#include "BatchCompiler.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "CompilerSession.h"
+#include "utils/ThreadPool.h"
+
+namespace Cli {
+std::vector<BatchCompiler::Unit> BatchCompiler::read_manifest(
+    const std::filesystem::path& path) {
+  std::ifstream is(path);
+
+  if (!is) {
+    throw std::runtime_error(
+        fmt::format("Failed to open manifest {:?}.", path.string()));
+  }
+
+  std::vector<Unit> result;
+  std::string line;
+
+  for (size_t line_number = 1; std::getline(is, line); ++line_number) {
+    std::istringstream words(line);
+    // argument parser expects program name first
+    std::vector<std::string> arguments{"compiler"};
+
+    for (std::string word; words >> word;) {
+      arguments.push_back(std::move(word));
+    }
+
+    if (arguments.size() == 1 || arguments[1].starts_with('#')) {
+      continue;
+    }
+
+    result.push_back({line_number, std::move(arguments)});
+  }
+
+  return result;
+}
+
+int BatchCompiler::compile(const std::filesystem::path& manifest) {
+  auto units = read_manifest(manifest);
+  auto working_directory = std::filesystem::absolute(manifest).parent_path();
+
+  CompilerSession session;
+  std::vector<CompilationOutput> outputs(units.size());
+
+  {
+    ThreadPool pool(std::max(std::thread::hardware_concurrency(), 1u));
+
+    for (size_t i = 0; i < units.size(); ++i) {
+      pool.submit([&, i] {
+        outputs[i] = session.compile(units[i].arguments, working_directory);
+      });
+    }
+
+    pool.wait();
+  }
+
+  size_t failed_count = 0;
+
+  for (size_t i = 0; i < units.size(); ++i) {
+    const auto& [exit_code, out, err] = outputs[i];
+
+    std::cout << out;
+
+    if (exit_code != 0) {
+      ++failed_count;
+      std::cerr << fmt::format("{}:{}: unit failed\n", manifest.string(),
+                               units[i].line);
+    }
+
+    std::cerr << err;
+  }
+
+  if (failed_count != 0) {
+    std::cerr << fmt::format("{} of {} units failed.\n", failed_count,
+                             units.size());
+    return 1;
+  }
+
+  return 0;
+}
+}  // namespace Cli
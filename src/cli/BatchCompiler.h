@@ -0,0 +1,25 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Cli {
+// Compiles independent units listed in a manifest in one CompilerSession.
+// Each line of manifest holds the usual compiler arguments of one unit
+// separated by whitespaces, relative paths are resolved against directory of
+// the manifest. Empty lines and lines starting with # are skipped.
+// Units are compiled in parallel, their outputs are printed in manifest order.
+class BatchCompiler {
+  struct Unit {
+    size_t line;
+    std::vector<std::string> arguments;
+  };
+
+  static std::vector<Unit> read_manifest(const std::filesystem::path& path);
+
+ public:
+  // returns 0 when all units are compiled successfully
+  static int compile(const std::filesystem::path& manifest);
+};
+}  // namespace Cli
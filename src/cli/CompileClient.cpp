@@ -0,0 +1,41 @@
+#include "CompileClient.h"
+
+#include <fmt/format.h>
+
+#include <iostream>
+#include <stdexcept>
+
+#include "ServerProtocol.h"
+
+namespace Cli {
+namespace {
+CompilationOutput send_request(const std::filesystem::path& socket_path,
+                               const ServerRequest& request) {
+  Socket socket = Socket::connect(socket_path);
+
+  if (!socket.is_valid()) {
+    throw std::runtime_error(fmt::format(
+        "Compile server is not running on {:?}.", socket_path.string()));
+  }
+
+  ServerProtocol::send(socket, request);
+  return ServerProtocol::receive_response(socket);
+}
+}  // namespace
+
+int CompileClient::compile(const std::filesystem::path& socket_path,
+                           std::vector<std::string> arguments) {
+  ServerRequest request{.working_directory = std::filesystem::current_path(),
+                        .arguments = std::move(arguments)};
+
+  CompilationOutput response = send_request(socket_path, request);
+  std::cout << response.out << std::flush;
+  std::cerr << response.err << std::flush;
+
+  return response.exit_code;
+}
+
+void CompileClient::shutdown(const std::filesystem::path& socket_path) {
+  send_request(socket_path, ServerRequest{.is_shutdown = true});
+}
+}  // namespace Cli
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Cli {
+// Thin client of CompileServer: it sends arguments and working directory to
+// the server and prints what the server has written into stdout and stderr.
+// Client loads neither tables nor sources itself.
+class CompileClient {
+ public:
+  // arguments are the usual compiler arguments, first one is a program name,
+  // returns exit code of compilation
+  static int compile(const std::filesystem::path& socket_path,
+                     std::vector<std::string> arguments);
+
+  static void shutdown(const std::filesystem::path& socket_path);
+};
+}  // namespace Cli
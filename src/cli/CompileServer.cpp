@@ -0,0 +1,73 @@
+#include "CompileServer.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <csignal>
+#include <iostream>
+#include <thread>
+
+#include "utils/ThreadPool.h"
+
+namespace Cli {
+CompileServer::CompileServer(std::filesystem::path socket_path)
+    : socket_path_(std::move(socket_path)),
+      jobs_(std::max(std::thread::hardware_concurrency(), 1u)) {}
+
+void CompileServer::serve(const Socket& connection) {
+  try {
+    ServerRequest request = ServerProtocol::receive_request(connection);
+    CompilationOutput response;
+
+    if (request.is_shutdown) {
+      stop();
+    } else {
+      response =
+          session_.compile(request.arguments, request.working_directory);
+    }
+
+    ServerProtocol::send(connection, response);
+  } catch (const std::exception& exception) {
+    // broken connection affects only its own request
+    std::cerr << fmt::format("Failed to serve request: {}\n",
+                             exception.what());
+  }
+}
+
+void CompileServer::stop() {
+  is_stopped_ = true;
+
+  // wakes up accept in run
+  Socket::connect(socket_path_);
+}
+
+void CompileServer::run() {
+  // client may disconnect before response is sent
+  std::signal(SIGPIPE, SIG_IGN);
+
+  Socket listener = Socket::listen(socket_path_);
+  std::cerr << fmt::format("Compile server is listening on {}\n",
+                           socket_path_.string());
+
+  {
+    ThreadPool pool(jobs_);
+
+    while (!is_stopped_) {
+      // std::function must be copyable, so connection is shared
+      auto connection = std::make_shared<Socket>(listener.accept());
+
+      if (is_stopped_) {
+        break;
+      }
+
+      if (connection->is_valid()) {
+        pool.submit([this, connection] { serve(*connection); });
+      }
+    }
+
+    pool.wait();
+  }
+
+  std::filesystem::remove(socket_path_);
+}
+}  // namespace Cli
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+
+#include "CompilerSession.h"
+#include "ServerProtocol.h"
+
+namespace Cli {
+// Daemon that compiles requests of `--connect` clients in one
+// CompilerSession, so modules that didn't change since the previous request
+// are not parsed or compiled again. Requests are served concurrently.
+class CompileServer {
+  std::filesystem::path socket_path_;
+
+  // number of requests that are compiled at the same time
+  size_t jobs_;
+
+  CompilerSession session_;
+  std::atomic<bool> is_stopped_{false};
+
+  void serve(const Socket& connection);
+  void stop();
+
+ public:
+  explicit CompileServer(std::filesystem::path socket_path);
+
+  // returns after shutdown request
+  void run();
+};
+}  // namespace Cli
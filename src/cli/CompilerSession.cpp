@@ -0,0 +1,53 @@
+#include "CompilerSession.h"
+
+#include <sstream>
+
+#include "ArgumentsReader.h"
+#include "compilation/TeaFrontend.h"
+#include "errors/ExceptionsHandler.h"
+
+namespace Cli {
+CompilerSession::CompilerSession()
+    : parser_tables_(std::make_shared<const Front::ParserTables>()) {}
+
+std::shared_ptr<Front::ModuleCache> CompilerSession::get_module_cache(
+    const std::filesystem::path& directory) {
+  std::lock_guard lock(module_caches_mutex_);
+
+  auto& result = module_caches_[directory.lexically_normal().string()];
+  if (!result) {
+    result = std::make_shared<Front::ModuleCache>(directory, true);
+  }
+
+  return result;
+}
+
+CompilationOutput CompilerSession::compile(
+    const std::vector<std::string>& arguments,
+    const std::filesystem::path& working_directory) {
+  std::ostringstream out;
+  std::ostringstream err;
+
+  int exit_code = 1;
+  ExceptionsHandler::execute(
+      [&] {
+        auto config =
+            ArgumentsReader::read_remote(arguments, working_directory);
+
+        Front::TeaFrontendEnvironment environment{
+            .out = &out, .err = &err, .parser_tables = parser_tables_};
+
+        if (!config.module_cache_directory.empty()) {
+          environment.module_cache =
+              get_module_cache(config.module_cache_directory);
+        }
+
+        auto front =
+            Front::TeaFrontend(std::move(config), std::move(environment));
+        exit_code = front.compile();
+      },
+      err);
+
+  return {exit_code, std::move(out).str(), std::move(err).str()};
+}
+}  // namespace Cli
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ServerProtocol.h"
+#include "compilation/ModuleCache.h"
+#include "compilation/ParserTables.h"
+
+namespace Cli {
+// Runs many independent compilations in one process. Lexis and grammar tables
+// are loaded once, module caches (see --module-cache) are shared between
+// compilations and keep their entries in memory. Compilations can run
+// concurrently, each one has its own TeaFrontend.
+class CompilerSession {
+  std::shared_ptr<const Front::ParserTables> parser_tables_;
+
+  // cache directory -> cache
+  std::mutex module_caches_mutex_;
+  std::unordered_map<std::string, std::shared_ptr<Front::ModuleCache>>
+      module_caches_;
+
+  std::shared_ptr<Front::ModuleCache> get_module_cache(
+      const std::filesystem::path& directory);
+
+ public:
+  CompilerSession();
+
+  // arguments are the usual compiler arguments, first one is a program name,
+  // relative paths are resolved against working directory
+  CompilationOutput compile(const std::vector<std::string>& arguments,
+                            const std::filesystem::path& working_directory);
+};
+}  // namespace Cli
@@ -0,0 +1,232 @@
+#include "ServerProtocol.h"
+
+#include <fmt/format.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace Cli {
+namespace {
+// requests are small, limit protects server from garbage sizes
+constexpr size_t kMaxMessageSize = size_t{1} << 30;
+
+sockaddr_un get_address(const std::filesystem::path& path) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+
+  const std::string& string = path.native();
+  if (string.size() >= sizeof(address.sun_path)) {
+    throw std::runtime_error(
+        fmt::format("Socket path {:?} is too long.", string));
+  }
+
+  std::memcpy(address.sun_path, string.c_str(), string.size() + 1);
+  return address;
+}
+
+int create_socket() {
+  int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+  if (fd < 0) {
+    throw std::runtime_error(
+        fmt::format("Failed to create socket: {}.", std::strerror(errno)));
+  }
+
+  return fd;
+}
+}  // namespace
+
+Socket::Socket(Socket&& other) noexcept
+    : fd_(std::exchange(other.fd_, -1)) {}
+
+Socket& Socket::operator=(Socket&& other) noexcept {
+  std::swap(fd_, other.fd_);
+  return *this;
+}
+
+Socket::~Socket() {
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+}
+
+Socket Socket::connect(const std::filesystem::path& path) {
+  sockaddr_un address = get_address(path);
+  Socket result(create_socket());
+
+  if (::connect(result.fd_, reinterpret_cast<const sockaddr*>(&address),
+                sizeof(address)) != 0) {
+    return {};
+  }
+
+  return result;
+}
+
+Socket Socket::listen(const std::filesystem::path& path) {
+  sockaddr_un address = get_address(path);
+
+  // socket file is left behind when server is killed
+  if (std::filesystem::exists(path)) {
+    if (connect(path).is_valid()) {
+      throw std::runtime_error(fmt::format(
+          "Compile server is already running on {:?}.", path.string()));
+    }
+
+    std::filesystem::remove(path);
+  }
+
+  Socket result(create_socket());
+
+  if (::bind(result.fd_, reinterpret_cast<const sockaddr*>(&address),
+             sizeof(address)) != 0 ||
+      ::listen(result.fd_, SOMAXCONN) != 0) {
+    throw std::runtime_error(fmt::format("Failed to listen on {:?}: {}.",
+                                         path.string(), std::strerror(errno)));
+  }
+
+  return result;
+}
+
+Socket Socket::accept() const {
+  return Socket(::accept(fd_, nullptr, nullptr));
+}
+
+void ServerProtocol::write_string(std::string_view string, std::ostream& os) {
+  write_varint(string.size(), os);
+  os.write(string.data(), string.size());
+}
+
+std::string ServerProtocol::read_string(std::istream& is) {
+  size_t size = read_varint(is);
+
+  // string can't be longer than the rest of the message
+  if (!is || size > kMaxMessageSize) {
+    throw std::runtime_error("Malformed compile server message.");
+  }
+
+  std::string result(size, '\0');
+  is.read(result.data(), result.size());
+
+  if (!is) {
+    throw std::runtime_error("Malformed compile server message.");
+  }
+
+  return result;
+}
+
+void ServerProtocol::send_message(const Socket& socket,
+                                  std::string_view message) {
+  std::ostringstream os;
+  write_bytes(message.size(), os);
+  os << message;
+
+  std::string data = std::move(os).str();
+  std::string_view rest = data;
+
+  while (!rest.empty()) {
+    ssize_t written = ::write(socket.get(), rest.data(), rest.size());
+
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+
+    if (written <= 0) {
+      throw std::runtime_error(fmt::format(
+          "Failed to send compile server message: {}.", std::strerror(errno)));
+    }
+
+    rest.remove_prefix(written);
+  }
+}
+
+std::string ServerProtocol::receive_message(const Socket& socket) {
+  auto receive = [&socket](char* data, size_t size) {
+    while (size > 0) {
+      ssize_t count = ::read(socket.get(), data, size);
+
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+
+      if (count <= 0) {
+        throw std::runtime_error("Compile server connection was closed.");
+      }
+
+      data += count;
+      size -= count;
+    }
+  };
+
+  size_t size;
+  receive(reinterpret_cast<char*>(&size), sizeof(size));
+
+  if (size > kMaxMessageSize) {
+    throw std::runtime_error("Malformed compile server message.");
+  }
+
+  std::string result(size, '\0');
+  receive(result.data(), result.size());
+  return result;
+}
+
+void ServerProtocol::send(const Socket& socket, const ServerRequest& request) {
+  std::ostringstream os;
+
+  os.put(request.is_shutdown ? 1 : 0);
+  write_string(request.working_directory.native(), os);
+  write_varint(request.arguments.size(), os);
+
+  for (const auto& argument : request.arguments) {
+    write_string(argument, os);
+  }
+
+  send_message(socket, os.str());
+}
+
+void ServerProtocol::send(const Socket& socket,
+                          const CompilationOutput& response) {
+  std::ostringstream os;
+
+  write_varint(response.exit_code, os);
+  write_string(response.out, os);
+  write_string(response.err, os);
+
+  send_message(socket, os.str());
+}
+
+ServerRequest ServerProtocol::receive_request(const Socket& socket) {
+  std::istringstream is(receive_message(socket));
+  ServerRequest result;
+
+  result.is_shutdown = is.get() == 1;
+  result.working_directory = read_string(is);
+
+  size_t count = read_varint(is);
+  if (!is || count > kMaxMessageSize) {
+    throw std::runtime_error("Malformed compile server message.");
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    result.arguments.push_back(read_string(is));
+  }
+
+  return result;
+}
+
+CompilationOutput ServerProtocol::receive_response(const Socket& socket) {
+  std::istringstream is(receive_message(socket));
+  CompilationOutput result;
+
+  result.exit_code = static_cast<int>(read_varint(is));
+  result.out = read_string(is);
+  result.err = read_string(is);
+
+  return result;
+}
+}  // namespace Cli
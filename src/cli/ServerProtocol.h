@@ -0,0 +1,71 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "utils/Serializer.h"
+
+namespace Cli {
+// Owning wrapper over Unix domain socket.
+class Socket {
+  int fd_{-1};
+
+ public:
+  Socket() = default;
+  explicit Socket(int fd) : fd_(fd) {}
+
+  Socket(Socket&& other) noexcept;
+  Socket& operator=(Socket&& other) noexcept;
+
+  Socket(const Socket&) = delete;
+  Socket& operator=(const Socket&) = delete;
+
+  ~Socket();
+
+  // returns invalid socket when nobody listens on the path
+  static Socket connect(const std::filesystem::path& path);
+  static Socket listen(const std::filesystem::path& path);
+
+  // returns invalid socket on failure
+  Socket accept() const;
+
+  bool is_valid() const { return fd_ >= 0; }
+  int get() const { return fd_; }
+};
+
+struct ServerRequest {
+  // relative paths in arguments are resolved against it
+  std::filesystem::path working_directory;
+  // arguments of usual compiler invocation, first one is a program name
+  std::vector<std::string> arguments;
+  // server finishes after running requests are served
+  bool is_shutdown{false};
+};
+
+// server responds with the output of compilation
+struct CompilationOutput {
+  int exit_code{0};
+  std::string out;
+  std::string err;
+};
+
+// Compile server and client make one connection per request. Each message is
+// its size followed by payload, strings in payload are prefixed with their
+// varint sizes. Failures of transfer are reported with std::runtime_error.
+class ServerProtocol : Serializer {
+  static void write_string(std::string_view string, std::ostream& os);
+  static std::string read_string(std::istream& is);
+
+  static void send_message(const Socket& socket, std::string_view message);
+  static std::string receive_message(const Socket& socket);
+
+ public:
+  static void send(const Socket& socket, const ServerRequest& request);
+  static void send(const Socket& socket, const CompilationOutput& response);
+
+  static ServerRequest receive_request(const Socket& socket);
+  static CompilationOutput receive_response(const Socket& socket);
+};
+}  // namespace Cli
@@ -1,6 +1,13 @@
 #include <argparse/argparse.hpp>
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include "ArgumentsReader.h"
+#include "BatchCompiler.h"
+#include "CompileClient.h"
+#include "CompileServer.h"
 #include "ast/ASTPrinter.h"
 #include "compilation/TeaFrontend.h"
 #include "errors/ExceptionsHandler.h"
@@ -14,13 +21,85 @@ namespace Cli {
 namespace fs = std::filesystem;
 
 class Main {
+  static constexpr std::string_view kRunCommand = "run";
+  static constexpr std::string_view kBatchFlag = "--batch";
+  static constexpr std::string_view kServerFlag = "--server";
+  static constexpr std::string_view kConnectFlag = "--connect";
+  static constexpr std::string_view kShutdownFlag = "--shutdown";
+
+  // help is printed by client itself, server doesn't accept these flags
+  static bool is_help_requested(const std::vector<std::string>& arguments) {
+    return std::ranges::any_of(arguments, [](std::string_view argument) {
+      return argument == "-h" || argument == "--help" || argument == "-v" ||
+             argument == "--version";
+    });
+  }
+
  public:
   static int main(int argc, char* argv[]) {
-    return ExceptionsHandler::execute([argc, argv] {
-      auto config = ArgumentsReader::read(argc, argv);
+    std::vector<std::string> arguments(argv, argv + argc);
+
+    // batch and server modes are handled before usual arguments parsing,
+    // because they don't take sources
+    if (arguments.size() == 3 && arguments[1] == kBatchFlag) {
+      int exit_code = 1;
+      ExceptionsHandler::execute(
+          [&] { exit_code = BatchCompiler::compile(arguments[2]); });
+
+      return exit_code;
+    }
+
+    if (arguments.size() == 3 && arguments[1] == kServerFlag) {
+      return ExceptionsHandler::execute(
+          [&arguments] { CompileServer(arguments[2]).run(); });
+    }
+
+    if (arguments.size() >= 3 && arguments[1] == kConnectFlag) {
+      fs::path socket_path = arguments[2];
+      arguments.erase(arguments.begin() + 1, arguments.begin() + 3);
+
+      if (arguments.size() == 2 && arguments[1] == kShutdownFlag) {
+        return ExceptionsHandler::execute(
+            [&socket_path] { CompileClient::shutdown(socket_path); });
+      }
+
+      // program would be executed in the server process, so `run` is
+      // rejected before connecting
+      if (arguments.size() >= 2 && arguments[1] == kRunCommand) {
+        return ExceptionsHandler::execute([] {
+          throw ArgumentsParseException(
+              "`run` can't be used with --connect, compile the program and "
+              "run it locally.");
+        });
+      }
+
+      if (!is_help_requested(arguments)) {
+        int exit_code = 1;
+        ExceptionsHandler::execute([&] {
+          exit_code = CompileClient::compile(socket_path, std::move(arguments));
+        });
+
+        return exit_code;
+      }
+    }
+
+    // `run` executes program in compiler process instead of emitting it
+    bool is_run = arguments.size() >= 2 && arguments[1] == kRunCommand;
+    if (is_run) {
+      arguments.erase(arguments.begin() + 1);
+    }
+
+    int exit_code = 1;
+    ExceptionsHandler::execute([&] {
+      auto config = ArgumentsReader::read(arguments);
+
+      if (is_run) {
+        config.run = true;
+        config.emit_type = Front::EmitType::IR;
+      }
 
       auto front = Front::TeaFrontend(std::move(config));
-      front.compile();
+      exit_code = front.compile();
 
       // Front::GlobalContext context;
       // auto& source_manager = context.source_manager;
@@ -58,6 +137,8 @@ class Main {
       //   }
       // }
     });
+
+    return exit_code;
   }
 };
 }  // namespace Cli
@@ -0,0 +1,108 @@
+#include "ASTCache.h"
+
+#include <fmt/format.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+
+#include "ast/ASTSerializer.h"
+#include "utils/Constants.h"
+#include "utils/Hashers.h"
+
+namespace Front {
+namespace {
+size_t hash_file(const std::filesystem::path& path) {
+  std::ifstream is(path, std::ios::binary);
+
+  if (!is) {
+    throw std::runtime_error(
+        fmt::format("Failed to open {} for AST cache.", path.string()));
+  }
+
+  std::stringstream buffer;
+  buffer << is.rdbuf();
+  return std::hash<std::string>()(buffer.str());
+}
+}  // namespace
+
+ASTCache::ASTCache(std::filesystem::path directory)
+    : directory_(std::move(directory)), tables_hash_(get_tables_hash()) {
+  std::filesystem::create_directories(directory_);
+}
+
+size_t ASTCache::get_tables_hash() {
+  StreamHasher hasher;
+  hasher << hash_file(
+      Constants::GetRuntimeFilePath(Constants::lexis_relative_filepath));
+  hasher << hash_file(
+      Constants::GetRuntimeFilePath(Constants::grammar_relative_filepath));
+  return hasher.get_hash();
+}
+
+size_t ASTCache::get_key(std::string_view source) const {
+  StreamHasher hasher;
+  hasher << source << source.size() << tables_hash_ << kFormatVersion;
+  return hasher.get_hash();
+}
+
+std::filesystem::path ASTCache::get_entry_path(size_t key) const {
+  return directory_ / fmt::format("{:016x}.ast", key);
+}
+
+bool ASTCache::load(SourceView source, ModuleContext& context) const {
+  size_t key = get_key(source.string_view());
+  std::ifstream is(get_entry_path(key), std::ios::binary);
+
+  if (!is) {
+    return false;
+  }
+
+  // header protects from collisions of file names and from stale entries
+  if (read_bytes(is) != kMagic || read_bytes(is) != key ||
+      read_bytes(is) != source.string_view().size() || !is) {
+    return false;
+  }
+
+  try {
+    context.ast_root = ASTSerializer::deserialize(
+        is, context, source.begin_location().file_id);
+  } catch (const ASTDeserializationException&) {
+    return false;
+  }
+
+  return true;
+}
+
+void ASTCache::store(SourceView source, const ModuleContext& context) const {
+  size_t key = get_key(source.string_view());
+  auto path = get_entry_path(key);
+
+  // entry is written into temporary file and then renamed, so concurrent
+  // compilations never observe partially written entry
+  auto temporary_path = path;
+  temporary_path += fmt::format(".{}.tmp", getpid());
+
+  bool is_written = [&] {
+    std::ofstream os(temporary_path, std::ios::binary);
+
+    write_bytes(kMagic, os);
+    write_bytes(key, os);
+    write_bytes(source.string_view().size(), os);
+    ASTSerializer::serialize(os, context);
+
+    os.close();
+    return !os.fail();
+  }();
+
+  // cache is only an optimization, failing to write it is not an error
+  std::error_code error;
+  if (is_written) {
+    std::filesystem::rename(temporary_path, path, error);
+  }
+
+  if (!is_written || error) {
+    std::filesystem::remove(temporary_path, error);
+  }
+}
+}  // namespace Front
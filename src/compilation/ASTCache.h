@@ -0,0 +1,35 @@
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+
+#include "compilation/ModuleContext.h"
+#include "sources/SourceManager.h"
+#include "utils/Serializer.h"
+
+namespace Front {
+// On-disk storage of serialized ASTs.
+// Entry is keyed by the hash of the source text, the hash of lexis and grammar
+// tables and serialization format version, so any change of those leads to
+// cache miss and ordinary parsing. Entries are never removed automatically.
+class ASTCache : Serializer {
+  static constexpr uint32_t kMagic = 0x54534154;  // "TAST"
+  static constexpr size_t kFormatVersion = 1;
+
+  std::filesystem::path directory_;
+  size_t tables_hash_;
+
+  size_t get_key(std::string_view source) const;
+  std::filesystem::path get_entry_path(size_t key) const;
+
+ public:
+  explicit ASTCache(std::filesystem::path directory);
+
+  // hash of lexis and grammar tables, parsing results depend on them
+  static size_t get_tables_hash();
+
+  // on hit fills context.ast_root and returns true
+  bool load(SourceView source, ModuleContext& context) const;
+  void store(SourceView source, const ModuleContext& context) const;
+};
+}  // namespace Front
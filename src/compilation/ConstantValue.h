@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+namespace Front {
+// Value of expression known at compile time. Integers are kept as bits
+// truncated to width of their type, bools are 0 or 1. Tuples hold their
+// elements.
+struct ConstantValue {
+  std::variant<uint64_t, std::vector<ConstantValue>> value;
+
+  bool is_integer() const { return std::holds_alternative<uint64_t>(value); }
+
+  uint64_t get_integer() const { return std::get<uint64_t>(value); }
+
+  const std::vector<ConstantValue>& get_elements() const {
+    return std::get<std::vector<ConstantValue>>(value);
+  }
+};
+}  // namespace Front
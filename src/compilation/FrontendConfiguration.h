@@ -3,15 +3,81 @@
 #include <filesystem>
 #include <string>
 #include <unordered_map>
+#include <vector>
+
+#include "errors/DiagnosticsEngine.h"
 
 namespace Front {
 
-enum class EmitType { AST, IR };
+// BC is bitcode, ASM and OBJ are produced by target machine in process
+enum class EmitType { AST, IR, BC, ASM, OBJ };
+
+// standard LLVM pipelines, Os optimizes for size
+enum class OptimizationLevel { O0, O1, O2, O3, Os };
+
+// empty fields mean host defaults, like in llc
+struct TargetConfiguration {
+  // replaces architecture of host triple
+  std::string arch;
+  // `native` means CPU of the host
+  std::string cpu;
+  // comma separated features, like `+avx2,-sse4.1`
+  std::string features;
+};
 
 struct TeaFrontendConfiguration {
   std::unordered_map<std::string, std::filesystem::path> sources;
   std::filesystem::path output_file;
   EmitType emit_type;
+
+  // serialized ASTs of unchanged sources are loaded from here instead of
+  // parsing, empty path disables the cache
+  std::filesystem::path ast_cache_directory;
+
+  // interfaces and bitcode of compiled modules are stored here and reused
+  // when neither source nor interfaces of dependencies change, empty path
+  // disables the cache
+  std::filesystem::path module_cache_directory;
+
+  // pipeline that is run on linked module, O0 emits IR as it is generated
+  OptimizationLevel optimization_level{OptimizationLevel::O0};
+
+  TargetConfiguration target;
+
+  // modules aren't linked into one, each one is optimized with ThinLTO
+  // cross-module importing and compiled into its own object file (or
+  // assembly) next to the output file, modules are processed in parallel
+  bool thin_lto{false};
+
+  // program is compiled by JIT and its main is called instead of emitting
+  bool run{false};
+  // shared libraries where extern symbols of the program are looked up in
+  // run mode
+  std::vector<std::filesystem::path> libraries;
+
+  // number of threads that analyze and compile independent modules
+  size_t jobs{1};
+
+  // write precompiled interface of each compiled module next to output file
+  bool emit_interfaces{false};
+
+  // print time and memory usage of each compilation phase to stderr
+  bool time_report{false};
+
+  // print time of each LLVM optimization pass to stderr
+  bool time_passes{false};
+
+  // print allocations made by each frontend subsystem to stderr, works only
+  // when built with TEALANG_ALLOCATION_PROFILING
+  bool mem_report{false};
+
+  // file where trace of compilation phases is written in Chrome trace-event
+  // format, empty path disables tracing
+  std::filesystem::path trace_file;
+
+  // compilation stops after this number of errors, 0 means no limit
+  size_t max_errors{20};
+  DiagnosticsFormat diagnostics_format{DiagnosticsFormat::TEXT};
 };
 
 }  // namespace Front
@@ -0,0 +1,109 @@
+#include "Jit.h"
+
+#include <fmt/format.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/IR/IRBuilder.h>
+
+#include <stdexcept>
+
+#include "Target.h"
+
+namespace Front {
+namespace {
+constexpr auto kEntryName = "__tea_run_main";
+
+void check(llvm::Error error) {
+  if (error) {
+    throw std::runtime_error(llvm::toString(std::move(error)));
+  }
+}
+
+template <typename T>
+T unwrap(llvm::Expected<T> value) {
+  check(value.takeError());
+  return std::move(*value);
+}
+
+// Adds `i32 __tea_run_main()` that calls main and converts its result to exit
+// code, so main with any integer or unit return type is called with correct
+// ABI.
+void add_entry(llvm::Module& module) {
+  llvm::Function* main = module.getFunction("main");
+  if (main == nullptr || main->arg_size() != 0) {
+    throw std::runtime_error("Program must have `main: () -> ...` function.");
+  }
+
+  llvm::Type* return_type = main->getReturnType();
+  if (!return_type->isVoidTy() && !return_type->isIntegerTy()) {
+    throw std::runtime_error("`main` must return integer or unit.");
+  }
+
+  auto& context = module.getContext();
+  auto* entry = llvm::Function::Create(
+      llvm::FunctionType::get(llvm::Type::getInt32Ty(context), false),
+      llvm::Function::ExternalLinkage, kEntryName, module);
+
+  llvm::IRBuilder<> builder(llvm::BasicBlock::Create(context, "entry", entry));
+  llvm::Value* result = builder.CreateCall(main);
+
+  if (return_type->isVoidTy()) {
+    builder.CreateRet(builder.getInt32(0));
+  } else {
+    builder.CreateRet(builder.CreateIntCast(result, builder.getInt32Ty(),
+                                            /*isSigned=*/true));
+  }
+}
+}  // namespace
+
+int run_main(std::unique_ptr<llvm::Module> module,
+             std::unique_ptr<llvm::LLVMContext> context,
+             const llvm::TargetMachine& target_machine,
+             const std::vector<std::filesystem::path>& libraries) {
+  initialize_targets();
+  add_entry(*module);
+
+  // JIT generates code for the same target as --emit obj would
+  llvm::orc::JITTargetMachineBuilder machine_builder(
+      target_machine.getTargetTriple());
+  machine_builder.setCPU(target_machine.getTargetCPU().str());
+  machine_builder.getFeatures() =
+      llvm::SubtargetFeatures(target_machine.getTargetFeatureString());
+  machine_builder.setCodeGenOptLevel(target_machine.getOptLevel());
+
+  auto jit = unwrap(llvm::orc::LLJITBuilder()
+                        .setJITTargetMachineBuilder(std::move(machine_builder))
+                        .create());
+
+  auto& main_library = jit->getMainJITDylib();
+  char prefix = jit->getDataLayout().getGlobalPrefix();
+
+  // generators are searched in order of addition
+  for (const auto& library : libraries) {
+    auto generator = llvm::orc::DynamicLibrarySearchGenerator::Load(
+        library.c_str(), prefix);
+
+    if (!generator) {
+      throw std::runtime_error(
+          fmt::format("Can't load library {:?}: {}", library.string(),
+                      llvm::toString(generator.takeError())));
+    }
+
+    main_library.addGenerator(std::move(*generator));
+  }
+
+  main_library.addGenerator(unwrap(
+      llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(prefix)));
+
+  check(jit->addIRModule(llvm::orc::ThreadSafeModule(
+      std::move(module), llvm::orc::ThreadSafeContext(std::move(context)))));
+
+  auto entry = unwrap(jit->lookup(kEntryName)).toPtr<int32_t()>();
+
+  check(jit->initialize(main_library));
+  int exit_code = entry();
+  check(jit->deinitialize(main_library));
+
+  return exit_code;
+}
+}  // namespace Front
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Target/TargetMachine.h>
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace Front {
+// Compiles module with ORC LLJIT for the target of the machine and calls its
+// main, returns value of main as exit code. Extern symbols are looked up in
+// the libraries first, then in the compiler process itself.
+// Throws std::runtime_error when module can't be compiled or linked.
+int run_main(std::unique_ptr<llvm::Module> module,
+             std::unique_ptr<llvm::LLVMContext> context,
+             const llvm::TargetMachine& target_machine,
+             const std::vector<std::filesystem::path>& libraries);
+}  // namespace Front
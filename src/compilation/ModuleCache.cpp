@@ -0,0 +1,200 @@
+#include "ModuleCache.h"
+
+#include <fmt/format.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/FileSystem.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <thread>
+
+#include "ASTCache.h"
+#include "utils/Hashers.h"
+
+namespace Front {
+ModuleCache::ModuleCache(std::filesystem::path directory, bool keep_in_memory)
+    : directory_(std::move(directory)),
+      tables_hash_(ASTCache::get_tables_hash()),
+      keep_in_memory_(keep_in_memory) {
+  std::filesystem::create_directories(directory_);
+}
+
+size_t ModuleCache::get_build_id() {
+  static const size_t build_id = [] {
+    StreamHasher hasher;
+    hasher << kFormatVersion;
+
+    // address of any function of the executable lets LLVM find it where
+    // /proc is unavailable
+    std::filesystem::path executable = llvm::sys::fs::getMainExecutable(
+        nullptr, reinterpret_cast<void*>(&ModuleCache::get_build_id));
+
+    std::error_code size_error;
+    std::error_code time_error;
+    auto size = std::filesystem::file_size(executable, size_error);
+    auto time = std::filesystem::last_write_time(executable, time_error);
+    if (!size_error && !time_error) {
+      hasher << size << time.time_since_epoch().count();
+    }
+
+    return hasher.get_hash();
+  }();
+
+  return build_id;
+}
+
+size_t ModuleCache::get_source_key(std::string_view source) const {
+  // keys of interfaces and bitcode are built on top of source key, so build
+  // id invalidates all of them
+  StreamHasher hasher;
+  hasher << source << source.size() << tables_hash_ << get_build_id();
+  return hasher.get_hash();
+}
+
+size_t ModuleCache::get_interface_key(std::string_view interface,
+                                      const std::vector<size_t>& dependencies) {
+  StreamHasher hasher;
+  hasher << interface << interface.size();
+
+  for (size_t dependency : dependencies) {
+    hasher << dependency;
+  }
+
+  return hasher.get_hash();
+}
+
+size_t ModuleCache::get_module_key(size_t source_key,
+                                   const std::vector<size_t>& dependencies,
+                                   std::string_view target_triple) {
+  StreamHasher hasher;
+  hasher << source_key << std::string_view(LLVM_VERSION_STRING)
+         << target_triple;
+
+  for (size_t dependency : dependencies) {
+    hasher << dependency;
+  }
+
+  return hasher.get_hash();
+}
+
+std::filesystem::path ModuleCache::get_entry_path(
+    size_t key, std::string_view extension) const {
+  return directory_ / fmt::format("{:016x}.{}", key, extension);
+}
+
+std::optional<std::string> ModuleCache::load(size_t key,
+                                             std::string_view extension) const {
+  auto path = get_entry_path(key, extension);
+
+  if (keep_in_memory_) {
+    std::lock_guard lock(memory_mutex_);
+
+    auto itr = memory_.find(path.filename().string());
+    if (itr != memory_.end()) {
+      return itr->second;
+    }
+  }
+
+  auto result = load_file(path, key);
+  if (result) {
+    remember(path, *result);
+  }
+
+  return result;
+}
+
+void ModuleCache::remember(const std::filesystem::path& path,
+                           std::string_view payload) const {
+  if (!keep_in_memory_) {
+    return;
+  }
+
+  std::lock_guard lock(memory_mutex_);
+  memory_.insert_or_assign(path.filename().string(), std::string(payload));
+}
+
+std::optional<std::string> ModuleCache::load_file(
+    const std::filesystem::path& path, size_t key) const {
+  std::ifstream is(path, std::ios::binary);
+
+  if (!is || read_bytes(is) != kMagic || read_bytes(is) != key || !is) {
+    return std::nullopt;
+  }
+
+  size_t size = read_bytes(is);
+  if (!is) {
+    return std::nullopt;
+  }
+
+  // size is checked against the file to not allocate garbage amounts
+  auto payload_begin = is.tellg();
+  is.seekg(0, std::ios::end);
+  if (!is || is.tellg() - payload_begin != static_cast<std::streamoff>(size)) {
+    return std::nullopt;
+  }
+  is.seekg(payload_begin);
+
+  std::string result(size, '\0');
+  is.read(result.data(), result.size());
+
+  if (!is) {
+    return std::nullopt;
+  }
+
+  return result;
+}
+
+void ModuleCache::store(size_t key, std::string_view extension,
+                        std::string_view payload) const {
+  auto path = get_entry_path(key, extension);
+
+  // same approach as in ASTCache: write into temporary file and rename
+  auto temporary_path = path;
+  // modules are compiled in parallel, so thread id is added too
+  temporary_path += fmt::format(
+      ".{}.{}.tmp", getpid(),
+      std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+  bool is_written = [&] {
+    std::ofstream os(temporary_path, std::ios::binary);
+
+    write_bytes(kMagic, os);
+    write_bytes(key, os);
+    write_bytes(payload.size(), os);
+    os.write(payload.data(), payload.size());
+
+    os.close();
+    return !os.fail();
+  }();
+
+  std::error_code error;
+  if (is_written) {
+    std::filesystem::rename(temporary_path, path, error);
+  }
+
+  if (!is_written || error) {
+    std::filesystem::remove(temporary_path, error);
+  }
+
+  remember(path, payload);
+}
+
+std::optional<std::string> ModuleCache::load_interface(
+    size_t source_key) const {
+  return load(source_key, "tmi");
+}
+
+void ModuleCache::store_interface(size_t source_key,
+                                  std::string_view interface) const {
+  store(source_key, "tmi", interface);
+}
+
+std::optional<std::string> ModuleCache::load_bitcode(size_t module_key) const {
+  return load(module_key, "bc");
+}
+
+void ModuleCache::store_bitcode(size_t module_key,
+                                std::string_view bitcode) const {
+  store(module_key, "bc", bitcode);
+}
+}  // namespace Front
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "utils/Serializer.h"
+
+namespace Front {
+// On-disk storage of compiled modules for incremental compilation.
+// Interface of a module (see ModuleInterface) depends only on its source, so
+// it is keyed by the source key. Bitcode is keyed by the source key and
+// interface keys of the imported modules, so changes that don't touch
+// interfaces of dependencies don't lead to recompilation.
+// Entries are never removed automatically.
+// Compile server shares one cache between requests and keeps loaded entries in
+// memory as well, so unchanged modules don't even touch the disk.
+class ModuleCache : Serializer {
+  static constexpr uint32_t kMagic = 0x4d534154;  // "TASM"
+
+  // must be bumped when format of entries changes, changes of semantic
+  // analysis and code generation are covered by build id
+  static constexpr size_t kFormatVersion = 3;
+
+  std::filesystem::path directory_;
+  size_t tables_hash_;
+
+  // file name of entry -> payload, is never trimmed
+  bool keep_in_memory_;
+  mutable std::mutex memory_mutex_;
+  mutable std::unordered_map<std::string, std::string> memory_;
+
+  // identifies build of the compiler by size and modification time of its
+  // executable, so entries of other builds are never loaded
+  static size_t get_build_id();
+
+  std::filesystem::path get_entry_path(size_t key,
+                                       std::string_view extension) const;
+
+  std::optional<std::string> load_file(
+      const std::filesystem::path& path, size_t key) const;
+  void remember(const std::filesystem::path& path,
+                std::string_view payload) const;
+
+  std::optional<std::string> load(size_t key, std::string_view extension) const;
+  void store(size_t key, std::string_view extension,
+             std::string_view payload) const;
+
+ public:
+  explicit ModuleCache(std::filesystem::path directory,
+                       bool keep_in_memory = false);
+
+  size_t get_source_key(std::string_view source) const;
+
+  // interface key covers interfaces of all transitive dependencies, because
+  // exported declarations can refer to imported types
+  static size_t get_interface_key(std::string_view interface,
+                                  const std::vector<size_t>& dependencies);
+  // bitcode follows ABI of the target triple
+  static size_t get_module_key(size_t source_key,
+                               const std::vector<size_t>& dependencies,
+                               std::string_view target_triple);
+
+  std::optional<std::string> load_interface(size_t source_key) const;
+  void store_interface(size_t source_key, std::string_view interface) const;
+
+  std::optional<std::string> load_bitcode(size_t module_key) const;
+  void store_bitcode(size_t module_key, std::string_view bitcode) const;
+};
+}  // namespace Front
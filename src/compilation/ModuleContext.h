@@ -1,6 +1,9 @@
 #pragma once
 
+#include <unordered_set>
+
 #include "ast/Nodes.h"
+#include "compilation/ConstantValue.h"
 #include "compilation/Scope.h"
 #include "types/TypesStorage.h"
 #include "utils/StringPool.h"
@@ -31,9 +34,21 @@ struct ModuleContext {
   std::unordered_map<const FunctionDecl*,
                      std::reference_wrapper<FunctionSymbolInfo>>
       functions_info;
+  // variables declared outside of functions and classes
+  std::unordered_map<const VariableDecl*,
+                     std::reference_wrapper<VariableSymbolInfo>>
+      global_variables_info;
   std::unordered_map<const UserDefinedTypeNode*,
                      std::reference_wrapper<SymbolInfo>>
       user_defined_types;
+  NameLookupCache name_lookup_cache;
+
+  // filled by ConstantEvaluator, only the largest folded subexpressions are
+  // kept
+  std::unordered_map<const Expression*, ConstantValue> constants;
+  // copies of tuples that are the last use of local variable, filled by
+  // LastUseAnalyzer
+  std::unordered_set<const Expression*> moved_values;
 
   // warning: StringIds inside QualifierId are from another module.
   // To get string_view from it, get_string must be called on correct
@@ -0,0 +1,63 @@
+#include "ModuleInterface.h"
+
+#include <fmt/format.h>
+
+#include <fstream>
+
+#include "ast/ASTSerializer.h"
+
+namespace Front {
+void ModuleInterface::write(const std::filesystem::path& path,
+                            const ModuleContext& context) {
+  std::ofstream os(path, std::ios::binary);
+
+  write_bytes(kMagic, os);
+  write_bytes(kFormatVersion, os);
+  write_bytes(context.name.size(), os);
+  os.write(context.name.data(), context.name.size());
+
+  ASTSerializer::serialize_interface(os, context);
+
+  os.close();
+  if (os.fail()) {
+    throw std::runtime_error(fmt::format(
+        "Failed to write interface of module {:?} into {}.", context.name,
+        path.string()));
+  }
+}
+
+void ModuleInterface::read(const std::filesystem::path& path,
+                           ModuleContext& context, uint32_t file_id) {
+  auto error = [&](std::string_view reason) {
+    return std::runtime_error(
+        fmt::format("Failed to load interface of module {:?} from {}: {}.",
+                    context.name, path.string(), reason));
+  };
+
+  std::ifstream is(path, std::ios::binary);
+  if (!is) {
+    throw error("file can't be opened");
+  }
+
+  if (read_bytes(is) != kMagic || read_bytes(is) != kFormatVersion || !is) {
+    throw error("not an interface file or incompatible version");
+  }
+
+  size_t name_size = read_bytes(is);
+  if (!is || name_size != context.name.size()) {
+    throw error("interface is built for other module");
+  }
+
+  std::string name(name_size, '\0');
+  is.read(name.data(), name.size());
+  if (!is || name != context.name) {
+    throw error("interface is built for other module");
+  }
+
+  try {
+    context.ast_root = ASTSerializer::deserialize(is, context, file_id);
+  } catch (const ASTDeserializationException& exception) {
+    throw error(exception.what());
+  }
+}
+}  // namespace Front
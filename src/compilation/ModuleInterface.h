@@ -0,0 +1,29 @@
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+
+#include "compilation/ModuleContext.h"
+#include "utils/Serializer.h"
+
+namespace Front {
+// Precompiled interface of a module: declarations of its exported symbols
+// stored as serialized AST (see ASTSerializer::serialize_interface).
+// Interface is analyzed like an ordinary module, but all its functions are
+// extern, so it produces only declarations. Types and mangled names are
+// derived from these declarations in the same way as for the original module.
+class ModuleInterface : Serializer {
+  static constexpr uint32_t kMagic = 0x494d5454;  // "TTMI"
+  static constexpr size_t kFormatVersion = 1;
+
+ public:
+  static constexpr std::string_view kExtension = ".tmi";
+
+  static void write(const std::filesystem::path& path,
+                    const ModuleContext& context);
+
+  // fills context.ast_root, throws if file is not an interface of this module
+  static void read(const std::filesystem::path& path, ModuleContext& context,
+                   uint32_t file_id);
+};
+}  // namespace Front
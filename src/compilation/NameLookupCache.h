@@ -0,0 +1,54 @@
+#pragma once
+
+#include <optional>
+#include <unordered_map>
+
+#include "compilation/QualifiedId.h"
+#include "utils/Hashers.h"
+
+namespace Front {
+struct Scope;
+struct SymbolInfo;
+
+// Memoizes results of name lookup for pairs (scope, qualified id).
+// Result of the lookup of `a::b::c` from some scope depends only on the
+// nearest scope in the parent chain that declares `a`: symbols are never
+// removed or replaced, so once `b` and `c` are found they stay the same.
+// Therefore entries are grouped by the first part of the id and the whole
+// group is dropped when a symbol with that name is added to any scope.
+class NameLookupCache {
+  using Key = std::pair<const Scope*, QualifiedId>;
+
+  std::unordered_map<StringId, std::unordered_map<Key, SymbolInfo*>> entries_;
+
+  size_t hits_{0};
+  size_t misses_{0};
+
+ public:
+  // returns std::nullopt when result is not cached
+  // cached result can be nullptr if symbol wasn't found
+  std::optional<SymbolInfo*> find(const Scope* scope, const QualifiedId& id) {
+    auto group_itr = entries_.find(id.parts.front());
+    if (group_itr != entries_.end()) {
+      auto itr = group_itr->second.find(Key(scope, id));
+
+      if (itr != group_itr->second.end()) {
+        ++hits_;
+        return itr->second;
+      }
+    }
+
+    ++misses_;
+    return std::nullopt;
+  }
+
+  void insert(const Scope* scope, const QualifiedId& id, SymbolInfo* info) {
+    entries_[id.parts.front()].emplace(Key(scope, id), info);
+  }
+
+  void invalidate(StringId name) { entries_.erase(name); }
+
+  size_t hits() const { return hits_; }
+  size_t misses() const { return misses_; }
+};
+}  // namespace Front
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "lexis/LexicalAnalyzer.h"
+#include "syntax/lr/LRParser.h"
+#include "utils/Constants.h"
+
+namespace Front {
+// Lexis and grammar tables loaded once and shared between compilations.
+// LRParser has no state of its own, lexical analyzer is copied for each
+// compilation (copies share the table).
+struct ParserTables {
+  Lexis::LexicalAnalyzer lexical_analyzer;
+  Syntax::LRParser parser;
+
+  ParserTables()
+      : lexical_analyzer(
+            Constants::GetRuntimeFilePath(Constants::lexis_relative_filepath)),
+        parser(Constants::GetRuntimeFilePath(
+            Constants::grammar_relative_filepath)) {}
+};
+}  // namespace Front
@@ -3,14 +3,18 @@
 #include <fmt/format.h>
 #include <fmt/ranges.h>
 
-#include <vector>
-
 #include "utils/Hashers.h"
+#include "utils/SmallVector.h"
 #include "utils/StringPool.h"
 
 namespace Front {
 struct QualifiedId {
-  std::vector<StringId> parts;
+  // most of the names consist of one to three parts, so they are stored inline
+  // without heap allocation
+  static constexpr size_t kInlinePartsCount = 3;
+  using PartsT = SmallVector<StringId, kInlinePartsCount>;
+
+  PartsT parts;
 
   bool operator==(const QualifiedId&) const = default;
 
@@ -1,8 +1,10 @@
 #pragma once
 
+#include "NameLookupCache.h"
 #include "SymbolInfo.h"
 #include "ast/Nodes.h"
 #include "compilation/types/Type.h"
+#include "profiling/AllocationProfiler.h"
 #include "utils/StringId.h"
 
 namespace Front {
@@ -12,29 +14,46 @@ struct Scope {
   std::vector<std::unique_ptr<Scope>> children;
   Scope* parent{nullptr};
 
+  // shared by all scopes of one module, see NameLookupCache
+  NameLookupCache* lookup_cache{nullptr};
+
+  // symbols must be added only through add_* methods to keep lookup cache
+  // consistent
   std::unordered_map<StringId, SymbolInfo> symbols;
 
   bool has_symbol(StringId name) const { return symbols.contains(name); }
 
+  SymbolInfo& add_symbol(StringId name, SymbolInfo info) {
+    Profiling::AllocationScope allocation_scope(
+        Profiling::AllocationTag::SCOPES);
+
+    if (lookup_cache != nullptr) {
+      lookup_cache->invalidate(name);
+    }
+
+    return symbols.emplace(name, std::move(info)).first->second;
+  }
+
   SymbolInfo& add_namespace(StringId name, Declaration& decl, Scope* subscope) {
-    auto info = NamespaceSymbolInfo(this, subscope, decl);
-    return symbols.emplace(name, info).first->second;
+    return add_symbol(name, NamespaceSymbolInfo(this, subscope, decl));
   }
 
   SymbolInfo& add_variable(StringId name, Declaration& decl, Type* type) {
-    auto info = VariableSymbolInfo(this, decl, type);
-    return symbols.emplace(name, info).first->second;
+    return add_symbol(name, VariableSymbolInfo(this, decl, type));
   }
 
   SymbolInfo& add_function(StringId name, Declaration& decl, FunctionType* type,
                            Scope* subscope) {
-    auto info = FunctionSymbolInfo(this, subscope, decl, type);
-    return symbols.emplace(name, info).first->second;
+    return add_symbol(name, FunctionSymbolInfo(this, subscope, decl, type));
   }
 
   Scope& add_child(StringId name) {
+    Profiling::AllocationScope allocation_scope(
+        Profiling::AllocationTag::SCOPES);
+
     auto& child = children.emplace_back(std::make_unique<Scope>(name));
     child->parent = this;
+    child->lookup_cache = lookup_cache;
     return *child;
   }
 
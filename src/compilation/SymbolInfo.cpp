@@ -8,17 +8,43 @@
 namespace Front {
 
 QualifiedId BaseSymbolInfo::get_fully_qualified_name() const {
-  std::vector<StringId> result;
-  result.push_back(declaration.name);
+  QualifiedId result;
+  result.parts.push_back(declaration.name);
 
   Scope* current_scope = scope;
   while (current_scope->parent != nullptr) {
-    result.push_back(current_scope->name);
+    result.parts.push_back(current_scope->name);
     current_scope = current_scope->parent;
   }
 
-  std::ranges::reverse(result);
-  return QualifiedId{std::move(result)};
+  std::ranges::reverse(result.parts);
+  return result;
+}
+
+bool BaseSymbolInfo::is_visible_outside() const {
+  if (get_specifiers().is_exported()) {
+    return true;
+  }
+
+  // all members of exported namespace are exported
+  for (Scope* current_scope = scope; current_scope->parent != nullptr;
+       current_scope = current_scope->parent) {
+    const SymbolInfo& symbol =
+        current_scope->parent->symbols.at(current_scope->name);
+
+    if (symbol.is_namespace() &&
+        symbol.get_declaration().specifiers.is_exported()) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool VariableSymbolInfo::is_global() const {
+  // namespaces don't set parent symbol of their scopes
+  SymbolInfo* parent = scope->get_parent_symbol();
+  return parent == nullptr || parent->is_namespace();
 }
 
 Type* SymbolInfo::get_type() const {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <optional>
+
 #include "ast/Nodes.h"
 #include "types/Type.h"
 
@@ -24,6 +26,9 @@ struct BaseSymbolInfo {
   DeclarationSpecifiers get_specifiers() const {
     return declaration.specifiers;
   }
+
+  // exported itself or member of exported namespace
+  bool is_visible_outside() const;
 };
 
 struct VariableSymbolInfo;
@@ -45,12 +50,28 @@ struct VariableSymbolInfo : BaseSymbolInfo {
   VariableDecl& get_decl() const {
     return static_cast<VariableDecl&>(declaration);
   }
+
+  // declared outside of functions and classes
+  bool is_global() const;
+};
+
+// inferred by EffectsAnalyzer
+struct FunctionEffects {
+  // accesses only memory of its arguments and locals and doesn't unwind
+  bool is_pure{false};
+  // parameters whose memory is assigned to
+  std::vector<bool> written_parameters;
 };
 
 struct FunctionSymbolInfo : ScopefulSymbolInfo {
   FunctionType* type;
   std::vector<std::reference_wrapper<VariableSymbolInfo>> local_variables;
 
+  // only for functions defined in this module
+  std::optional<FunctionEffects> effects;
+  // defined in this module and can't be referenced from other modules
+  bool is_internal{false};
+
   FunctionSymbolInfo(Scope* scope, Scope* subscope, Declaration& declaration,
                      FunctionType* type)
       : ScopefulSymbolInfo(scope, declaration, subscope), type(type) {}
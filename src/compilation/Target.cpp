@@ -0,0 +1,70 @@
+#include "Target.h"
+
+#include <fmt/format.h>
+#include <llvm/MC/TargetRegistry.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/TargetParser/Host.h>
+#include <llvm/TargetParser/Triple.h>
+
+#include <mutex>
+#include <stdexcept>
+
+namespace Front {
+namespace {
+llvm::CodeGenOptLevel get_codegen_level(OptimizationLevel level) {
+  switch (level) {
+    case OptimizationLevel::O0:
+      return llvm::CodeGenOptLevel::None;
+    case OptimizationLevel::O1:
+      return llvm::CodeGenOptLevel::Less;
+    case OptimizationLevel::O3:
+      return llvm::CodeGenOptLevel::Aggressive;
+    default:
+      return llvm::CodeGenOptLevel::Default;
+  }
+}
+}  // namespace
+
+void initialize_targets() {
+  // compile server and batch mode create machines from several threads
+  static std::once_flag flag;
+
+  std::call_once(flag, [] {
+    llvm::InitializeAllTargetInfos();
+    llvm::InitializeAllTargets();
+    llvm::InitializeAllTargetMCs();
+    llvm::InitializeAllAsmPrinters();
+  });
+}
+
+std::unique_ptr<llvm::TargetMachine> create_target_machine(
+    const TargetConfiguration& target, OptimizationLevel optimization_level) {
+  initialize_targets();
+
+  llvm::Triple triple(llvm::sys::getDefaultTargetTriple());
+  std::string error;
+
+  // like llc, -march replaces architecture of the triple
+  const llvm::Target* llvm_target =
+      llvm::TargetRegistry::lookupTarget(target.arch, triple, error);
+
+  if (llvm_target == nullptr) {
+    throw std::runtime_error(
+        fmt::format("Unsupported target architecture: {}", error));
+  }
+
+  std::string cpu = target.cpu;
+  if (cpu.empty()) {
+    cpu = "generic";
+  } else if (cpu == "native") {
+    cpu = llvm::sys::getHostCPUName().str();
+  }
+
+  // position independent code links into default PIE executables
+  return std::unique_ptr<llvm::TargetMachine>(
+      llvm_target->createTargetMachine(
+          triple.str(), cpu, target.features, llvm::TargetOptions(),
+          llvm::Reloc::PIC_, std::nullopt,
+          get_codegen_level(optimization_level)));
+}
+}  // namespace Front
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <llvm/Target/TargetMachine.h>
+
+#include <memory>
+
+#include "FrontendConfiguration.h"
+
+namespace Front {
+// registers all targets in LLVM, can be called several times
+void initialize_targets();
+
+// Creates machine for target of the configuration, host is used by default.
+// Throws std::runtime_error when architecture isn't supported.
+std::unique_ptr<llvm::TargetMachine> create_target_machine(
+    const TargetConfiguration& target, OptimizationLevel optimization_level);
+}  // namespace Front
@@ -1,13 +1,19 @@
 #include "TeaFrontend.h"
 
 #include <llvm/ADT/APFloat.h>
+#include <llvm/ADT/SmallPtrSet.h>
 #include <llvm/ADT/STLExtras.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/IR/BasicBlock.h>
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/DerivedTypes.h>
 #include <llvm/IR/Function.h>
 #include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/PassManager.h>
+#include <llvm/IR/PassTimingInfo.h>
 #include <llvm/IR/Type.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/Linker/Linker.h>
@@ -24,17 +30,111 @@
 #include <llvm/Transforms/Scalar/Reassociate.h>
 #include <llvm/Transforms/Scalar/SimplifyCFG.h>
 
-#include <deque>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
 
 #include "ast/ASTPrinter.h"
+#include "ast/ASTSerializer.h"
+#include "compilation/Jit.h"
+#include "compilation/ModuleInterface.h"
+#include "compilation/Target.h"
+#include "compilation/ThinLto.h"
 #include "compilation/semantics/SemanticAnalyzer.h"
 #include "ir/IRGenerator.h"
 #include "lexis/LexicalAnalyzer.h"
 #include "syntax/lr/LRParser.h"
 #include "utils/Constants.h"
+#include "utils/ThreadPool.h"
 
 namespace Front {
+namespace {
+using Timer = Profiling::TimeReport::Timer;
+
+std::string write_bitcode(const llvm::Module& module) {
+  std::string result;
+  llvm::raw_string_ostream os(result);
+  llvm::WriteBitcodeToFile(module, os);
+  os.flush();
+
+  return result;
+}
+
+std::unique_ptr<llvm::Module> read_bitcode(std::string_view bitcode,
+                                           std::string_view name,
+                                           llvm::LLVMContext& context) {
+  llvm::MemoryBufferRef buffer(llvm::StringRef(bitcode.data(), bitcode.size()),
+                               llvm::StringRef(name.data(), name.size()));
+  auto result = llvm::parseBitcodeFile(buffer, context);
+
+  if (!result) {
+    throw std::runtime_error(
+        fmt::format("Failed to read bitcode of module {:?}: {}", name,
+                    llvm::toString(result.takeError())));
+  }
+
+  return std::move(*result);
+}
+
+// Whole program is linked into the module, so functions with local linkage
+// are called only from it. Main and all externally visible definitions are
+// roots, unreachable functions with local linkage and unused declarations are
+// removed, even when optimizer doesn't run.
+void strip_dead_functions(llvm::Module& module) {
+  llvm::SmallPtrSet<llvm::Function*, 32> reachable;
+  std::vector<llvm::Function*> worklist;
+
+  auto visit = [&](llvm::Function* function) {
+    if (reachable.insert(function).second) {
+      worklist.push_back(function);
+    }
+  };
+
+  for (llvm::Function& function : module) {
+    bool is_root = !function.isDeclaration() && !function.hasLocalLinkage();
+
+    // function used outside of code (e.g. in global initializer) is kept
+    for (llvm::User* user : function.users()) {
+      is_root = is_root || !llvm::isa<llvm::Instruction>(user);
+    }
+
+    if (is_root) {
+      visit(&function);
+    }
+  }
+
+  while (!worklist.empty()) {
+    llvm::Function* function = worklist.back();
+    worklist.pop_back();
+
+    for (llvm::Instruction& instruction : llvm::instructions(*function)) {
+      for (llvm::Value* operand : instruction.operands()) {
+        if (auto* callee = llvm::dyn_cast<llvm::Function>(operand)) {
+          visit(callee);
+        }
+      }
+    }
+  }
+
+  std::vector<llvm::Function*> dead;
+  for (llvm::Function& function : module) {
+    if (!reachable.contains(&function)) {
+      dead.push_back(&function);
+    }
+  }
+
+  // dead functions may call each other, so references are dropped first
+  for (llvm::Function* function : dead) {
+    function->dropAllReferences();
+  }
+
+  for (llvm::Function* function : dead) {
+    function->eraseFromParent();
+  }
+}
+}  // namespace
+
 enum class DFSState { UNVISITED, VISITING, VISITED };
 
 std::vector<std::string_view> has_loops_recursive(
@@ -79,35 +179,189 @@ std::vector<std::string_view> TeaFrontend::find_loops() const {
   return {};
 }
 
+bool TeaFrontend::is_interface_file(const std::filesystem::path& path) {
+  return path.extension() == ModuleInterface::kExtension;
+}
+
+bool TeaFrontend::load_cached_interface(ModuleContext& module,
+                                        ModuleCacheEntry& entry) {
+  entry.source_key = module_cache_->get_source_key(entry.source.string_view());
+
+  auto interface = module_cache_->load_interface(entry.source_key);
+  if (!interface) {
+    return false;
+  }
+
+  // interface has no source ranges, so its nodes point to the file start
+  std::istringstream is(std::move(*interface));
+
+  try {
+    module.ast_root = ASTSerializer::deserialize(
+        is, module, entry.source.begin_location().file_id);
+  } catch (const ASTDeserializationException&) {
+    return false;
+  }
+
+  entry.is_interface_loaded = true;
+  return true;
+}
+
+void TeaFrontend::lookup_module_cache(
+    const std::function<bool(ModuleContext&, SourceView)>& parse) {
+  std::unordered_map<std::string_view, size_t> interface_keys;
+  // interfaces of parsed modules, they replace full AST on bitcode hit
+  std::unordered_map<std::string_view, std::string> parsed_interfaces;
+
+  // there are no import loops at this point, so recursion terminates
+  std::function<size_t(const ModuleContext&)> get_interface_key =
+      [&](const ModuleContext& module) {
+        if (auto itr = interface_keys.find(module.name);
+            itr != interface_keys.end()) {
+          return itr->second;
+        }
+
+        std::vector<size_t> dependencies;
+        for (const ModuleContext& dependency : module.dependencies) {
+          dependencies.push_back(get_interface_key(dependency));
+        }
+
+        std::stringstream ss;
+        ASTSerializer::serialize_interface(ss, module);
+        std::string interface = ss.str();
+
+        // interfaces of parsed modules are stored for the next runs
+        auto entry = module_cache_entries_.find(module.name);
+        if (entry != module_cache_entries_.end() &&
+            !entry->second.is_interface_loaded) {
+          module_cache_->store_interface(entry->second.source_key, interface);
+          parsed_interfaces.emplace(module.name, interface);
+        }
+
+        size_t key = ModuleCache::get_interface_key(interface, dependencies);
+        interface_keys.emplace(module.name, key);
+        return key;
+      };
+
+  for (auto& [name, entry] : module_cache_entries_) {
+    ModuleContext& module = context_.get_module(name);
+
+    std::vector<size_t> dependencies;
+    for (const ModuleContext& dependency : module.dependencies) {
+      dependencies.push_back(get_interface_key(dependency));
+    }
+
+    // it is also called for module itself to store its interface
+    get_interface_key(module);
+
+    entry.module_key =
+        ModuleCache::get_module_key(entry.source_key, dependencies,
+                                    target_machine_->getTargetTriple().str());
+    entry.bitcode = module_cache_->load_bitcode(entry.module_key);
+
+    // interface of some dependency has changed, so full AST is needed
+    if (!entry.bitcode && entry.is_interface_loaded) {
+      if (!parse(module, entry.source)) {
+        throw std::runtime_error("Syntax errors encountered in files.");
+      }
+
+      entry.is_interface_loaded = false;
+    }
+
+    // compiled module is taken from cache, so dependents need only its
+    // declarations and analysis of function bodies is skipped
+    if (entry.bitcode && !entry.is_interface_loaded) {
+      std::istringstream is(std::move(parsed_interfaces.at(name)));
+      module.ast_root = ASTSerializer::deserialize(
+          is, module, entry.source.begin_location().file_id);
+      entry.is_interface_loaded = true;
+    }
+  }
+}
+
 void TeaFrontend::build_ast() {
   auto& source_manager = context_.source_manager;
   bool has_syntax_errors = false;
 
-  // setup parser and lexical analyzer and parser
+  // lexical analyzer is created on first cache miss
   // loading of tables occurs only once
-  Lexis::LexicalAnalyzer lexical_analyzer(
-      Constants::GetRuntimeFilePath(Constants::lexis_relative_filepath));
-  auto parser = Syntax::LRParser(
-      Constants::GetRuntimeFilePath(Constants::grammar_relative_filepath));
+  std::optional<Lexis::LexicalAnalyzer> lexical_analyzer;
 
-  // build ASTTree for each file separately
-  // TODO: this can be easily parallelized
-  for (const auto& [name, path] : files_) {
-    auto& module_context = context_.get_module(name);
+  // returns false on syntax errors, they are printed immediately
+  auto parse = [&](ModuleContext& module_context, SourceView source_view) {
+    // lexer is driven by parser, so lexing time is included here
+    Timer timer(time_report(), "parse", module_context.name);
 
-    SourceView source_view = source_manager.load(path);
-    lexical_analyzer.set_source_view(source_view);
+    if (ast_cache_ && ast_cache_->load(source_view, module_context)) {
+      return true;
+    }
+
+    if (!lexical_analyzer) {
+      if (!parser_tables_) {
+        parser_tables_ = std::make_shared<const ParserTables>();
+      }
+
+      lexical_analyzer.emplace(parser_tables_->lexical_analyzer);
+    }
+
+    lexical_analyzer->set_source_view(source_view);
 
     try {
-      parser.parse(lexical_analyzer, module_context, source_view);
-    } catch (Syntax::ParserException exception) {
-      has_syntax_errors = true;
+      parser_tables_->parser.parse(*lexical_analyzer, module_context,
+                                   source_view,
+                                   diagnostics_.get_remaining_errors());
 
+      if (ast_cache_) {
+        ast_cache_->store(source_view, module_context);
+      }
+    } catch (Syntax::ParserException exception) {
       for (const auto& [position, error] : exception.get_errors()) {
-        source_manager.add_annotation(position, error);
+        diagnostics_.error(position, error);
+      }
+
+      return false;
+    }
+
+    return true;
+  };
+
+  Timer build_timer(time_report(), "build AST");
+  Profiling::TraceScope trace("build AST");
+
+  // build ASTTree for each file separately
+  // TODO: this can be easily parallelized
+  for (const auto& [name, path] : files_) {
+    if (diagnostics_.has_reached_limit()) {
+      break;
+    }
+
+    auto& module_context = context_.get_module(name);
+
+    if (is_interface_file(path)) {
+      Timer timer(time_report(), "load interface", name);
+
+      // interface has no source text, its nodes refer to this placeholder
+      SourceView placeholder = source_manager.load_text(
+          fmt::format("<interface of module {}>", name));
+      ModuleInterface::read(path, module_context,
+                            placeholder.begin_location().file_id);
+    } else {
+      SourceView source_view = [&] {
+        Timer timer(time_report(), "load", name);
+        return source_manager.load(path);
+      }();
+
+      // on module cache hit only interface is loaded, full AST is built
+      // later if compiled module is not in cache
+      bool is_loaded = false;
+      if (module_cache_) {
+        auto& entry = module_cache_entries_[module_context.name];
+        entry.source = source_view;
+        is_loaded = load_cached_interface(module_context, entry);
       }
 
-      source_manager.print_annotations(std::cout);
+      if (!is_loaded && !parse(module_context, source_view)) {
+        has_syntax_errors = true;
+      }
     }
 
     module_context.state = ModuleContext::ModuleState::AFTER_PARSER;
@@ -117,6 +371,7 @@ void TeaFrontend::build_ast() {
     }
 
     // processing imports
+    Timer imports_timer(time_report(), "import resolution", name);
     for (const auto& import_decl : module_context.ast_root->imports) {
       std::string_view import_name =
           module_context.get_string(import_decl->name);
@@ -146,72 +401,208 @@ void TeaFrontend::build_ast() {
     throw std::runtime_error(fmt::format(
         "Compile error. Found loop in imports: {}.", fmt::join(loop, " -> ")));
   }
+
+  if (module_cache_) {
+    Timer timer(time_report(), "module cache lookup");
+    lookup_module_cache(parse);
+  }
+}
+
+std::unique_ptr<llvm::Module> TeaFrontend::compile_module(
+    ModuleContext& module, llvm::LLVMContext& llvm_context) {
+  // entries are not modified during compilation, so it is safe to read them
+  // from several threads
+  auto cache_entry = module_cache_entries_.find(module.name);
+  bool is_cached = cache_entry != module_cache_entries_.end();
+  bool is_bitcode_cached = is_cached && cache_entry->second.bitcode;
+
+  // on bitcode hit AST contains only the interface, symbols are restored from
+  // its declarations for dependents and nothing is analyzed without them
+  if (!is_bitcode_cached || !module.dependents.empty()) {
+    Timer timer(time_report(), "semantic analysis", module.name);
+
+    try {
+      auto analyzer = SemanticAnalyzer(module);
+      analyzer.analyze();
+
+      if (time_report_) {
+        const NameLookupCache& cache = module.name_lookup_cache;
+        time_report_->add_statistic("name lookup cache hits", module.name,
+                                    cache.hits());
+        time_report_->add_statistic("name lookup cache misses", module.name,
+                                    cache.misses());
+      }
+    } catch (const SemanticAnalyzerException& exception) {
+      // analyzer stops at the first error and throws it, so errors are
+      // printed here, after analysis of the module is unwound
+      for (const auto& [position, error] : exception.errors) {
+        diagnostics_.error(position, error);
+      }
+
+      throw;
+    }
+  }
+
+  module.state = ModuleContext::ModuleState::AFTER_SEMANTIC_ANALYZER;
+
+  if (is_bitcode_cached) {
+    Timer timer(time_report(), "bitcode loading", module.name);
+
+    module.state = ModuleContext::ModuleState::AFTER_IR_COMPILER;
+    return read_bitcode(*cache_entry->second.bitcode, module.name,
+                        llvm_context);
+  }
+
+  std::unique_ptr<llvm::Module> llvm_module;
+  {
+    Timer timer(time_report(), "IR generation", module.name);
+
+    auto ir_compiler = IRGenerator(llvm_context, module, *target_machine_);
+    llvm_module = ir_compiler.compile();
+  }
+
+  module.state = ModuleContext::ModuleState::AFTER_IR_COMPILER;
+
+  if (is_cached) {
+    module_cache_->store_bitcode(cache_entry->second.module_key,
+                                 write_bitcode(*llvm_module));
+  }
+
+  return llvm_module;
+}
+
+std::unique_ptr<llvm::Module> TeaFrontend::move_to_main_context(
+    std::unique_ptr<llvm::Module> module) const {
+  if (&module->getContext() == llvm_context_.get()) {
+    return module;
+  }
+
+  // llvm can't move modules between contexts directly
+  // so module is written into bitcode and then read back
+  return read_bitcode(write_bitcode(*module), module->getModuleIdentifier(),
+                      *llvm_context_);
 }
 
 void TeaFrontend::build_symbols_table_and_compile() {
-  std::deque<std::string_view> queue;
+  struct CompiledModule {
+    // when modules are compiled in parallel each one has its own context
+    std::unique_ptr<llvm::LLVMContext> llvm_context;
+    std::unique_ptr<llvm::Module> llvm_module;
+    // is written instead of keeping module in ThinLTO mode
+    std::string summary_bitcode;
+    std::exception_ptr error;
+  };
+
+  // all entries are created beforehand, so workers don't modify maps
+  // themselves, only values of their own entries
+  std::map<std::string_view, CompiledModule> compiled;
+  std::unordered_map<std::string_view, size_t> unprocessed_dependencies;
+  std::vector<std::string_view> independent;
 
   for (const auto& [name, module] : context_.get_modules()) {
+    compiled[name];
+    unprocessed_dependencies[name] = module.dependencies.size();
+
     if (module.dependencies.empty()) {
-      queue.push_back(name);
+      independent.push_back(name);
     }
   }
 
-  while (!queue.empty()) {
-    std::string_view current_name = queue.front();
-    queue.pop_front();
+  // module is scheduled when the last of its dependencies is compiled
+  std::mutex mutex;
+  ThreadPool pool(jobs_);
 
-    // check that all dependencies are already processed
-    ModuleContext& current_module = context_.get_module(current_name);
-    bool has_unprocessed_dependencies = false;
-    for (const ModuleContext& dependency : current_module.dependencies) {
-      if (dependency.state != ModuleContext::ModuleState::AFTER_IR_COMPILER) {
-        has_unprocessed_dependencies = true;
-        break;
-      }
-    }
+  // workers trace into tracer of this compilation
+  Profiling::Tracer* tracer = Profiling::Tracer::get_active();
+  auto submit = [&pool, tracer](std::function<void()> task) {
+    pool.submit([tracer, task = std::move(task)] {
+      Profiling::ActiveTracerScope active_tracer(tracer);
+      task();
+    });
+  };
 
-    if (has_unprocessed_dependencies) {
-      queue.push_back(current_name);
-      continue;
-    }
+  // workers' timers are nested into this one explicitly
+  Timer compilation_timer(time_report(), "compilation");
+  Profiling::TraceScope trace("compilation");
+
+  std::function<void(ModuleContext&)> process = [&](ModuleContext& module) {
+    CompiledModule& result = compiled.at(module.name);
+    Timer timer(time_report(), "module", module.name, &compilation_timer);
+    Profiling::TraceScope module_trace("module", module.name);
 
-    // build symbols table for module
     try {
-      auto analyzer = SemanticAnalyzer(current_module);
-      analyzer.analyze();
-    } catch (SemanticAnalyzerException exception) {
-      for (const auto& [position, error] : exception.errors) {
-        context_.source_manager.add_annotation(position, error);
+      if (diagnostics_.has_reached_limit()) {
+        throw std::runtime_error("Compilation is stopped after errors.");
       }
 
-      context_.source_manager.print_annotations(std::cout);
-      throw;
-    }
+      llvm::LLVMContext* llvm_context = llvm_context_.get();
+      if (jobs_ > 1) {
+        result.llvm_context = std::make_unique<llvm::LLVMContext>();
+        llvm_context = result.llvm_context.get();
+      }
 
-    auto ir_compiler = IRGenerator(*llvm_context_, current_module);
-    llvm_modules_.emplace_back(std::move(ir_compiler.compile()));
+      result.llvm_module = compile_module(module, *llvm_context);
 
-    current_module.state = ModuleContext::ModuleState::AFTER_IR_COMPILER;
+      if (thin_lto_) {
+        Timer summary_timer(time_report(), "ThinLTO summary", module.name);
 
-    for (const ModuleContext& dependent : current_module.dependents) {
-      if (dependent.state != ModuleContext::ModuleState::AFTER_IR_COMPILER) {
-        queue.push_back(dependent.name);
+        result.summary_bitcode = write_summary_bitcode(*result.llvm_module);
+
+        result.llvm_module.reset();
+        result.llvm_context.reset();
       }
+    } catch (...) {
+      // dependents of failed module are never scheduled
+      result.error = std::current_exception();
+      return;
+    }
+
+    std::lock_guard lock(mutex);
+    for (ModuleContext& dependent : module.dependents) {
+      if (--unprocessed_dependencies.at(dependent.name) == 0) {
+        submit([&process, &dependent] { process(dependent); });
+      }
+    }
+  };
+
+  for (std::string_view name : independent) {
+    ModuleContext& module = context_.get_module(name);
+    submit([&process, &module] { process(module); });
+  }
+
+  pool.wait();
+
+  // diagnostics are already printed by workers
+  for (auto& [name, result] : compiled) {
+    if (result.error) {
+      std::rethrow_exception(result.error);
     }
   }
-}
-void TeaFrontend::emit_ast() const {
-  std::ofstream ofs;
 
-  std::ostream& out = [&]() -> std::ostream& {
-    if (output_file_.empty()) {
-      return std::cout;
+  for (auto& [name, result] : compiled) {
+    if (thin_lto_) {
+      thin_lto_modules_.push_back(
+          {std::string(name), std::move(result.summary_bitcode)});
+    } else {
+      llvm_modules_.push_back(
+          move_to_main_context(std::move(result.llvm_module)));
     }
+  }
+}
 
-    ofs.open(output_file_);
-    return ofs;
-  }();
+std::ostream& TeaFrontend::open_output(std::ofstream& ofs,
+                                       std::ios::openmode mode) const {
+  if (output_file_.empty()) {
+    return out_;
+  }
+
+  ofs.open(output_file_, mode);
+  return ofs;
+}
+
+void TeaFrontend::emit_ast() const {
+  std::ofstream ofs;
+  std::ostream& out = open_output(ofs);
 
   for (auto& [name, module] : context_.get_modules()) {
     out << "Module: " << name << std::endl;
@@ -221,58 +612,311 @@ void TeaFrontend::emit_ast() const {
 
 void TeaFrontend::emit_ir(const llvm::Module& main_module) const {
   std::ofstream ofs;
+  llvm::raw_os_ostream llvm_out(open_output(ofs));
+  main_module.print(llvm_out, nullptr);
+}
+
+void TeaFrontend::emit_bitcode(const llvm::Module& main_module) const {
+  std::ofstream ofs;
+  open_output(ofs, std::ios::binary) << write_bitcode(main_module);
+}
+
+void TeaFrontend::emit_code(llvm::Module& main_module) const {
+  // code is generated into memory, because target machine needs seekable
+  // stream and out_ isn't a file in compile server
+  llvm::SmallVector<char, 0> buffer;
+  llvm::raw_svector_ostream os(buffer);
+
+  auto file_type = emit_type_ == EmitType::OBJ
+                       ? llvm::CodeGenFileType::ObjectFile
+                       : llvm::CodeGenFileType::AssemblyFile;
+
+  llvm::legacy::PassManager passes;
+  if (target_machine_->addPassesToEmitFile(passes, os, nullptr, file_type)) {
+    throw std::runtime_error("Target can't emit this type of file.");
+  }
+  passes.run(main_module);
+
+  std::ofstream ofs;
+  open_output(ofs, std::ios::binary)
+      .write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
 
-  std::ostream& out = [&]() -> std::ostream& {
-    if (output_file_.empty()) {
-      return std::cout;
+void TeaFrontend::emit_interfaces() const {
+  // output is required with interfaces and resolved against working directory
+  // of the client
+  std::filesystem::path directory = output_file_.parent_path();
+
+  for (const auto& [name, module] : context_.get_modules()) {
+    // modules loaded from interfaces already have one
+    if (is_interface_file(files_.at(name))) {
+      continue;
     }
 
-    ofs.open(output_file_);
-    return ofs;
-  }();
+    auto interface_path = directory / name;
+    interface_path += ModuleInterface::kExtension;
 
-  llvm::raw_os_ostream llvm_out(out);
-  main_module.print(llvm_out, nullptr);
+    ModuleInterface::write(interface_path, module);
+  }
 }
 
-TeaFrontend::TeaFrontend(TeaFrontendConfiguration config)
+void TeaFrontend::write_trace() {
+  std::ofstream os(trace_file_);
+  tracer_->write(os);
+
+  if (!os) {
+    throw std::runtime_error(
+        fmt::format("Failed to write trace into {}.", trace_file_.string()));
+  }
+}
+
+TeaFrontend::TeaFrontend(TeaFrontendConfiguration config,
+                         TeaFrontendEnvironment environment)
     : llvm_context_(std::make_unique<llvm::LLVMContext>()),
       files_(std::move(config.sources)),
       output_file_(std::move(config.output_file)),
-      emit_type_(config.emit_type) {}
+      emit_type_(config.emit_type),
+      optimization_level_(config.optimization_level),
+      target_(std::move(config.target)),
+      run_(config.run),
+      thin_lto_(config.thin_lto),
+      libraries_(std::move(config.libraries)),
+      time_passes_(config.time_passes),
+      jobs_(config.jobs),
+      emit_interfaces_(config.emit_interfaces),
+      trace_file_(std::move(config.trace_file)),
+      out_(*environment.out),
+      err_(*environment.err),
+      parser_tables_(std::move(environment.parser_tables)),
+      diagnostics_(context_.source_manager, out_, config.diagnostics_format,
+                   config.max_errors) {
+  if (!config.ast_cache_directory.empty()) {
+    ast_cache_.emplace(std::move(config.ast_cache_directory));
+  }
 
-int TeaFrontend::compile() {
-  OSO_FIRE();
+  if (config.time_report) {
+    time_report_.emplace();
+  }
 
-  // Creating context for each module before building ast
-  // this way we can store links to imported modules
-  for (const auto& name : files_ | std::views::keys) {
-    context_.add_module(name);
+  if (config.mem_report) {
+    allocations_before_ = Profiling::AllocationProfiler::get_stats();
   }
 
-  // For each module build ASTTree and store links to imported modules
-  build_ast();
+  if (!trace_file_.empty()) {
+    tracer_.emplace();
+  }
 
-  if (emit_type_ == EmitType::AST) {
-    emit_ast();
-    return 0;
+  // cached modules have no full AST, so it can't be printed
+  if (emit_type_ != EmitType::AST) {
+    if (environment.module_cache) {
+      module_cache_ = std::move(environment.module_cache);
+    } else if (!config.module_cache_directory.empty()) {
+      module_cache_ = std::make_shared<ModuleCache>(
+          std::move(config.module_cache_directory));
+    }
   }
+}
+
+void TeaFrontend::optimize(llvm::Module& module) {
+  if (optimization_level_ == OptimizationLevel::O0) {
+    return;
+  }
+
+  Timer timer(time_report(), "optimization");
+  Profiling::TraceScope trace("optimization");
+
+  llvm::LoopAnalysisManager loop_analyses;
+  llvm::FunctionAnalysisManager function_analyses;
+  llvm::CGSCCAnalysisManager cgscc_analyses;
+  llvm::ModuleAnalysisManager module_analyses;
+
+  // handler owns its timers, so concurrent compilations in server don't mix
+  // their timings
+  llvm::PassInstrumentationCallbacks instrumentation;
+  llvm::TimePassesHandler time_passes(time_passes_);
+  time_passes.registerCallbacks(instrumentation);
+
+  llvm::PassBuilder builder(target_machine_.get(),
+                            llvm::PipelineTuningOptions(), {},
+                            &instrumentation);
+  builder.registerModuleAnalyses(module_analyses);
+  builder.registerCGSCCAnalyses(cgscc_analyses);
+  builder.registerFunctionAnalyses(function_analyses);
+  builder.registerLoopAnalyses(loop_analyses);
+  builder.crossRegisterProxies(loop_analyses, function_analyses,
+                               cgscc_analyses, module_analyses);
+
+  llvm::OptimizationLevel level = [this] {
+    switch (optimization_level_) {
+      case OptimizationLevel::O1:
+        return llvm::OptimizationLevel::O1;
+      case OptimizationLevel::O2:
+        return llvm::OptimizationLevel::O2;
+      case OptimizationLevel::O3:
+        return llvm::OptimizationLevel::O3;
+      case OptimizationLevel::Os:
+        return llvm::OptimizationLevel::Os;
+      default:
+        return llvm::OptimizationLevel::O0;
+    }
+  }();
 
-  // For each module build symbol table and compile it into llvm IR
-  build_symbols_table_and_compile();
+  llvm::ModulePassManager passes = builder.buildPerModuleDefaultPipeline(level);
+  passes.run(module, module_analyses);
 
+  if (time_passes_) {
+    llvm::raw_os_ostream os(err_);
+    time_passes.setOutStream(os);
+    time_passes.print();
+  }
+}
+
+int TeaFrontend::link_and_emit() {
   // Link all llvm modules together
-  auto main_module = llvm::Module("main", *llvm_context_);
-  llvm::Linker linker(main_module);
+  auto main_module = std::make_unique<llvm::Module>("main", *llvm_context_);
+
+  main_module->setTargetTriple(target_machine_->getTargetTriple().str());
+  main_module->setDataLayout(target_machine_->createDataLayout());
+
+  {
+    Timer timer(time_report(), "linking");
+    Profiling::TraceScope trace("linking");
+    llvm::Linker linker(*main_module);
 
-  for (auto& module : llvm_modules_) {
-    linker.linkInModule(std::move(module));
+    for (auto& module : llvm_modules_) {
+      linker.linkInModule(std::move(module));
+    }
+    llvm_modules_.clear();
+  }
+
+  // without main it is a library, its users aren't known
+  llvm::Function* entrypoint = main_module->getFunction(Constants::entrypoint);
+  if (entrypoint != nullptr && !entrypoint->isDeclaration()) {
+    Timer timer(time_report(), "dead functions elimination");
+    Profiling::TraceScope trace("dead functions elimination");
+    strip_dead_functions(*main_module);
+  }
+
+  optimize(*main_module);
+
+  if (run_) {
+    Timer timer(time_report(), "JIT execution");
+    Profiling::TraceScope trace("JIT execution");
+
+    // JIT owns the module and its context from now on
+    return run_main(std::move(main_module), std::move(llvm_context_),
+                    *target_machine_, libraries_);
   }
-  llvm_modules_.clear();
 
   // Write linked module into output
-  emit_ir(main_module);
+  switch (emit_type_) {
+    case EmitType::BC: {
+      Timer timer(time_report(), "emit bitcode");
+      emit_bitcode(*main_module);
+      break;
+    }
+    case EmitType::ASM:
+    case EmitType::OBJ: {
+      Timer timer(time_report(), "code generation");
+      Profiling::TraceScope trace("code generation");
+      emit_code(*main_module);
+      break;
+    }
+    default: {
+      Timer timer(time_report(), "emit IR");
+      emit_ir(*main_module);
+    }
+  }
 
   return 0;
 }
+
+void TeaFrontend::emit_thin_lto() {
+  Timer timer(time_report(), "ThinLTO");
+  Profiling::TraceScope trace("ThinLTO");
+
+  auto outputs =
+      thin_lto_compile(thin_lto_modules_, *target_machine_,
+                       optimization_level_, emit_type_ == EmitType::ASM, jobs_);
+
+  // like interfaces, code of each module is written next to the output file,
+  // arguments reader requires it and resolves it against working directory of
+  // the client, so it is never written into working directory of server
+  std::filesystem::path directory = output_file_.parent_path();
+  for (const auto& [name, content] : outputs) {
+    auto path = directory / name;
+    path += emit_type_ == EmitType::ASM ? ".s" : ".o";
+
+    std::ofstream os(path, std::ios::binary);
+    os << content;
+    os.close();
+
+    if (os.fail()) {
+      throw std::runtime_error(fmt::format(
+          "Failed to write code of module {:?} into {}.", name, path.string()));
+    }
+  }
+}
+
+int TeaFrontend::compile() {
+  OSO_FIRE();
+
+  // thread may have served a traced compilation before, so untraced one
+  // deactivates tracer explicitly
+  Profiling::ActiveTracerScope active_tracer(tracer_ ? &*tracer_ : nullptr);
+
+  int exit_code = 0;
+
+  {
+    Timer timer(time_report(), "total");
+
+    // Creating context for each module before building ast
+    // this way we can store links to imported modules
+    for (const auto& name : files_ | std::views::keys) {
+      context_.add_module(name);
+    }
+
+    // calls follow C ABI of the target, so even IR depends on it. Machine is
+    // created before AST, because cached bitcode is keyed by target too
+    if (emit_type_ != EmitType::AST) {
+      target_machine_ = create_target_machine(target_, optimization_level_);
+    }
+
+    // For each module build ASTTree and store links to imported modules
+    build_ast();
+
+    if (emit_type_ == EmitType::AST) {
+      emit_ast();
+    } else {
+      // For each module build symbol table and compile it into llvm IR
+      build_symbols_table_and_compile();
+
+      if (emit_interfaces_) {
+        Timer interfaces_timer(time_report(), "emit interfaces");
+        emit_interfaces();
+      }
+
+      if (thin_lto_) {
+        emit_thin_lto();
+      } else {
+        exit_code = link_and_emit();
+      }
+    }
+  }
+
+  // report goes to stderr to not mix with output printed to stdout
+  if (time_report_) {
+    time_report_->print(err_);
+  }
+
+  if (allocations_before_) {
+    Profiling::AllocationProfiler::print(err_, *allocations_before_);
+  }
+
+  if (tracer_) {
+    write_trace();
+  }
+
+  return exit_code;
+}
 }  // namespace Front
@@ -2,39 +2,136 @@
 
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
+#include <llvm/Target/TargetMachine.h>
 
 #include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "ASTCache.h"
 #include "FrontendConfiguration.h"
 #include "GlobalContext.h"
+#include "ModuleCache.h"
+#include "ParserTables.h"
+#include "ThinLto.h"
+#include "profiling/AllocationProfiler.h"
+#include "profiling/TimeReport.h"
+#include "profiling/Tracer.h"
 #include "utils/OneShotObject.h"
 
 namespace Front {
 
+// State that outlives one compilation. By default everything is created on
+// demand, compile server creates it once and shares it between requests.
+struct TeaFrontendEnvironment {
+  // emitted code when there is no output file, and diagnostics
+  std::ostream* out = &std::cout;
+  // time report
+  std::ostream* err = &std::cerr;
+
+  std::shared_ptr<const ParserTables> parser_tables;
+
+  // is used instead of module cache directory from configuration
+  std::shared_ptr<ModuleCache> module_cache;
+};
+
 class TeaFrontend : OneShotObject {
   std::unique_ptr<llvm::LLVMContext> llvm_context_;
   std::vector<std::unique_ptr<llvm::Module>> llvm_modules_;
+  // modules aren't linked in ThinLTO mode, only their bitcode is kept
+  std::vector<ThinLtoModule> thin_lto_modules_;
+  // nullptr when only AST is emitted
+  std::unique_ptr<llvm::TargetMachine> target_machine_;
 
   std::unordered_map<std::string, std::filesystem::path> files_;
   std::filesystem::path output_file_;
   EmitType emit_type_;
+  OptimizationLevel optimization_level_;
+  TargetConfiguration target_;
+  bool run_;
+  bool thin_lto_;
+  std::vector<std::filesystem::path> libraries_;
+  bool time_passes_;
+  std::optional<ASTCache> ast_cache_;
+  std::shared_ptr<ModuleCache> module_cache_;
+  size_t jobs_;
+  bool emit_interfaces_;
+  std::optional<Profiling::TimeReport> time_report_;
+  // allocation counters at the start of compilation
+  std::optional<Profiling::AllocationProfiler::Stats> allocations_before_;
+  std::optional<Profiling::Tracer> tracer_;
+  std::filesystem::path trace_file_;
+
+  std::ostream& out_;
+  std::ostream& err_;
+  std::shared_ptr<const ParserTables> parser_tables_;
 
   GlobalContext context_;
+  DiagnosticsEngine diagnostics_;
+
+  // module cache state of each module that is compiled from source
+  struct ModuleCacheEntry {
+    SourceView source;
+    size_t source_key{0};
+    size_t module_key{0};
+
+    // ast_root contains only interface loaded from cache
+    bool is_interface_loaded{false};
+
+    // is set on cache hit, then IR generation is skipped
+    std::optional<std::string> bitcode;
+  };
+
+  std::unordered_map<std::string_view, ModuleCacheEntry>
+      module_cache_entries_;
+
+  // nullptr when report is disabled, timers do nothing then
+  Profiling::TimeReport* time_report() {
+    return time_report_ ? &*time_report_ : nullptr;
+  }
 
   std::vector<std::string_view> find_loops() const;
 
+  static bool is_interface_file(const std::filesystem::path& path);
+
+  bool load_cached_interface(ModuleContext& module, ModuleCacheEntry& entry);
+  void lookup_module_cache(
+      const std::function<bool(ModuleContext&, SourceView)>& parse);
+
   void build_ast();
   void build_symbols_table_and_compile();
+  std::unique_ptr<llvm::Module> compile_module(ModuleContext& module,
+                                               llvm::LLVMContext& llvm_context);
+  std::unique_ptr<llvm::Module> move_to_main_context(
+      std::unique_ptr<llvm::Module> module) const;
+
+  void optimize(llvm::Module& module);
+  // returns exit code of executed program in run mode, 0 otherwise
+  int link_and_emit();
+
+  // output file or out_ when there is no output file
+  std::ostream& open_output(std::ofstream& ofs,
+                            std::ios::openmode mode = std::ios::out) const;
 
   void emit_ast() const;
   void emit_ir(const llvm::Module& main_module) const;
+  void emit_bitcode(const llvm::Module& main_module) const;
+  void emit_code(llvm::Module& main_module) const;
+  void emit_thin_lto();
+  void emit_interfaces() const;
+  void write_trace();
 
  public:
-  explicit TeaFrontend(TeaFrontendConfiguration config);
+  explicit TeaFrontend(TeaFrontendConfiguration config,
+                       TeaFrontendEnvironment environment = {});
 
+  // returns exit code of the program in run mode, 0 otherwise
   int compile();
 };
 }  // namespace Front
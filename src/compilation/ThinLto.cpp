@@ -0,0 +1,120 @@
+#include "ThinLto.h"
+
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Analysis/ModuleSummaryAnalysis.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/LTO/LTO.h>
+#include <llvm/Support/Caching.h>
+#include <llvm/Support/Threading.h>
+
+#include <stdexcept>
+
+namespace Front {
+namespace {
+void check(llvm::Error error) {
+  if (error) {
+    throw std::runtime_error(llvm::toString(std::move(error)));
+  }
+}
+
+unsigned get_opt_level(OptimizationLevel level) {
+  switch (level) {
+    case OptimizationLevel::O0:
+      return 0;
+    case OptimizationLevel::O1:
+      return 1;
+    case OptimizationLevel::O3:
+      return 3;
+    default:
+      return 2;
+  }
+}
+
+llvm::lto::Config make_config(const llvm::TargetMachine& target_machine,
+                              OptimizationLevel optimization_level,
+                              bool emit_assembly) {
+  llvm::lto::Config config;
+  config.DefaultTriple = target_machine.getTargetTriple().str();
+  config.CPU = target_machine.getTargetCPU().str();
+
+  llvm::SmallVector<llvm::StringRef> features;
+  llvm::SplitString(target_machine.getTargetFeatureString(), features, ",");
+  for (llvm::StringRef feature : features) {
+    config.MAttrs.push_back(feature.str());
+  }
+
+  config.RelocModel = target_machine.getRelocationModel();
+  config.CGOptLevel = target_machine.getOptLevel();
+  config.OptLevel = get_opt_level(optimization_level);
+  config.CGFileType = emit_assembly ? llvm::CodeGenFileType::AssemblyFile
+                                    : llvm::CodeGenFileType::ObjectFile;
+
+  return config;
+}
+}  // namespace
+
+std::string write_summary_bitcode(const llvm::Module& module) {
+  llvm::ModuleSummaryIndex index = llvm::buildModuleSummaryIndex(
+      module, /*GetBFICallback=*/nullptr, /*PSI=*/nullptr);
+
+  std::string result;
+  llvm::raw_string_ostream os(result);
+  llvm::WriteBitcodeToFile(module, os, /*ShouldPreserveUseListOrder=*/false,
+                           &index);
+  os.flush();
+
+  return result;
+}
+
+std::vector<ThinLtoModule> thin_lto_compile(
+    const std::vector<ThinLtoModule>& modules,
+    const llvm::TargetMachine& target_machine,
+    OptimizationLevel optimization_level, bool emit_assembly, size_t jobs) {
+  llvm::lto::LTO lto(
+      make_config(target_machine, optimization_level, emit_assembly),
+      llvm::lto::createInProcessThinBackend(
+          llvm::heavyweight_hardware_concurrency(jobs)));
+
+  for (const auto& module : modules) {
+    auto input = llvm::lto::InputFile::create(
+        llvm::MemoryBufferRef(module.content, module.name));
+    check(input.takeError());
+
+    std::vector<llvm::lto::SymbolResolution> resolutions;
+    for (const auto& symbol : (*input)->symbols()) {
+      // each symbol is defined by exactly one module, so definition prevails
+      llvm::lto::SymbolResolution resolution;
+      resolution.Prevailing = !symbol.isUndefined();
+      resolution.FinalDefinitionInLinkageUnit = !symbol.isUndefined();
+      resolution.VisibleToRegularObj = true;
+      resolutions.push_back(resolution);
+    }
+
+    check(lto.add(std::move(*input), resolutions));
+  }
+
+  // every task writes only its own buffer, so backend threads don't need a
+  // lock here
+  size_t tasks_count = lto.getMaxTasks();
+  std::vector<llvm::SmallString<0>> buffers(tasks_count);
+  std::vector<std::string> names(tasks_count);
+
+  auto add_stream = [&](unsigned task, const llvm::Twine& module_name)
+      -> llvm::Expected<std::unique_ptr<llvm::CachedFileStream>> {
+    names[task] = module_name.str();
+    return std::make_unique<llvm::CachedFileStream>(
+        std::make_unique<llvm::raw_svector_ostream>(buffers[task]));
+  };
+
+  check(lto.run(add_stream));
+
+  std::vector<ThinLtoModule> result;
+  for (size_t task = 0; task < tasks_count; ++task) {
+    if (!names[task].empty()) {
+      result.push_back({std::move(names[task]), buffers[task].str().str()});
+    }
+  }
+
+  return result;
+}
+}  // namespace Front
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <llvm/IR/Module.h>
+#include <llvm/Target/TargetMachine.h>
+
+#include <string>
+#include <vector>
+
+#include "FrontendConfiguration.h"
+
+namespace Front {
+// bitcode of a module with ThinLTO summary, or code generated from it
+struct ThinLtoModule {
+  std::string name;
+  std::string content;
+};
+
+// Module must already have triple and data layout of the target.
+std::string write_summary_bitcode(const llvm::Module& module);
+
+// Optimizes modules with cross-module importing and generates object file
+// (or assembly) of each one, modules are processed in `jobs` threads. Symbols
+// stay visible outside their modules, because objects are linked by regular
+// linker. Throws std::runtime_error on LTO errors.
+std::vector<ThinLtoModule> thin_lto_compile(
+    const std::vector<ThinLtoModule>& modules,
+    const llvm::TargetMachine& target_machine,
+    OptimizationLevel optimization_level, bool emit_assembly, size_t jobs);
+}  // namespace Front
@@ -0,0 +1,194 @@
+#include "ABIInfo.h"
+
+#include <llvm/IR/DerivedTypes.h>
+
+#include "compilation/types/Type.h"
+
+namespace Front {
+namespace {
+constexpr uint64_t kRegisterSize = 8;
+
+// System V AMD64 ABI: aggregates up to two eightbytes of INTEGER class are
+// passed in general purpose registers, only if all of them fit, otherwise on
+// stack
+class X86_64ABIInfo final : public ABIInfo {
+  static constexpr uint64_t kMaxRegistersSize = 16;
+
+  llvm::Type* get_coerced_type(uint64_t size) const {
+    auto& context = types_mapper_.get_llvm_context();
+
+    if (size <= kRegisterSize) {
+      return llvm::IntegerType::get(context, size * 8);
+    }
+
+    return llvm::StructType::get(
+        llvm::Type::getInt64Ty(context),
+        llvm::IntegerType::get(context, (size - kRegisterSize) * 8));
+  }
+
+ protected:
+  ABIArgInfo classify_result(Type* type) const override {
+    if (!type->is_structural()) {
+      return classify_scalar(type);
+    }
+
+    uint64_t size = get_size(type);
+    if (size == 0 || size > kMaxRegistersSize) {
+      return ABIArgInfo{.kind = ABIArgInfo::Kind::INDIRECT};
+    }
+
+    return ABIArgInfo{.kind = ABIArgInfo::Kind::COERCED,
+                      .coerced_type = get_coerced_type(size)};
+  }
+
+  ABIArgInfo classify_argument(Type* type,
+                               size_t& free_registers) const override {
+    if (!type->is_structural()) {
+      free_registers -= std::min<size_t>(free_registers, 1);
+      return classify_scalar(type);
+    }
+
+    uint64_t size = get_size(type);
+    size_t registers = (size + kRegisterSize - 1) / kRegisterSize;
+
+    // empty classes keep being passed by pointer
+    if (size == 0) {
+      return ABIArgInfo{.kind = ABIArgInfo::Kind::INDIRECT};
+    }
+
+    if (size > kMaxRegistersSize || registers > free_registers) {
+      return ABIArgInfo{.kind = ABIArgInfo::Kind::INDIRECT, .is_byval = true};
+    }
+
+    free_registers -= registers;
+    return ABIArgInfo{.kind = ABIArgInfo::Kind::COERCED,
+                      .coerced_type = get_coerced_type(size)};
+  }
+
+  size_t get_argument_registers_count() const override { return 6; }
+
+ public:
+  using ABIInfo::ABIInfo;
+};
+
+// AAPCS64: composites up to 16 bytes are passed as one or two 64-bit
+// registers, bigger ones are passed by reference to a copy made by caller.
+// LLVM places [2 x i64] to consecutive registers or entirely on stack itself.
+class AArch64ABIInfo final : public ABIInfo {
+  static constexpr uint64_t kMaxRegistersSize = 16;
+
+  llvm::Type* get_coerced_type(uint64_t size) const {
+    auto* int64 = llvm::Type::getInt64Ty(types_mapper_.get_llvm_context());
+
+    if (size <= kRegisterSize) {
+      return int64;
+    }
+
+    return llvm::ArrayType::get(int64, 2);
+  }
+
+  ABIArgInfo classify(Type* type) const {
+    if (!type->is_structural()) {
+      return classify_scalar(type);
+    }
+
+    uint64_t size = get_size(type);
+    if (size == 0 || size > kMaxRegistersSize) {
+      return ABIArgInfo{.kind = ABIArgInfo::Kind::INDIRECT};
+    }
+
+    return ABIArgInfo{.kind = ABIArgInfo::Kind::COERCED,
+                      .coerced_type = get_coerced_type(size)};
+  }
+
+ protected:
+  ABIArgInfo classify_result(Type* type) const override {
+    return classify(type);
+  }
+
+  ABIArgInfo classify_argument(Type* type,
+                               size_t& free_registers) const override {
+    return classify(type);
+  }
+
+ public:
+  using ABIInfo::ABIInfo;
+};
+}  // namespace
+
+uint64_t ABIInfo::get_size(Type* type) const {
+  return data_layout_.getTypeAllocSize(types_mapper_(type));
+}
+
+ABIArgInfo ABIInfo::classify_scalar(Type* type) const {
+  ABIArgInfo result;
+  type = type->get_original();
+
+  if (!type->is_primitive() || static_cast<PrimitiveType*>(type)->width >= 32) {
+    return result;
+  }
+
+  result.extension = type->get_kind() == Type::Kind::SIGNED_INT
+                         ? ABIArgInfo::Extension::SIGN
+                         : ABIArgInfo::Extension::ZERO;
+  return result;
+}
+
+ABIArgInfo ABIInfo::classify_result(Type* type) const {
+  if (type->is_structural()) {
+    return ABIArgInfo{.kind = ABIArgInfo::Kind::INDIRECT};
+  }
+
+  return classify_scalar(type);
+}
+
+ABIArgInfo ABIInfo::classify_argument(Type* type,
+                                      size_t& free_registers) const {
+  return classify_result(type);
+}
+
+FunctionABI ABIInfo::get_function_abi(const FunctionType& type) const {
+  FunctionABI result;
+  size_t free_registers = get_argument_registers_count();
+
+  if (!type.return_type->is_unit()) {
+    result.result = classify_result(type.return_type);
+
+    // pointer to result takes the first register on x86-64
+    if (result.result.is_indirect() && free_registers > 0) {
+      --free_registers;
+    }
+  }
+
+  for (Type* argument : type.arguments) {
+    // unit is passed by value and takes no registers
+    if (argument->is_unit()) {
+      result.arguments.emplace_back();
+      continue;
+    }
+
+    result.arguments.push_back(classify_argument(argument, free_registers));
+  }
+
+  return result;
+}
+
+std::unique_ptr<ABIInfo> ABIInfo::create(const llvm::Triple& triple,
+                                         const llvm::DataLayout& data_layout,
+                                         TypesMapper& types_mapper) {
+  switch (triple.getArch()) {
+    case llvm::Triple::x86_64:
+      // Windows x64 uses different convention
+      if (!triple.isOSWindows()) {
+        return std::make_unique<X86_64ABIInfo>(data_layout, types_mapper);
+      }
+      break;
+    case llvm::Triple::aarch64:
+      return std::make_unique<AArch64ABIInfo>(data_layout, types_mapper);
+    default:
+      break;
+  }
+
+  return std::make_unique<ABIInfo>(data_layout, types_mapper);
+}
+}  // namespace Front
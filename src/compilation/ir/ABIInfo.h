@@ -0,0 +1,83 @@
+#pragma once
+
+#include <llvm/IR/DataLayout.h>
+#include <llvm/TargetParser/Triple.h>
+
+#include <memory>
+#include <vector>
+
+#include "TypesMapper.h"
+
+namespace Front {
+struct Type;
+struct FunctionType;
+
+// How one argument or result is passed between functions.
+struct ABIArgInfo {
+  enum class Kind {
+    // primitives and pointers are passed as they are
+    DIRECT,
+    // small aggregate is reinterpreted as `coerced_type` (integers) and passed
+    // in registers
+    COERCED,
+    // aggregate in memory, pointer to it is passed, result is returned through
+    // `sret` argument
+    INDIRECT,
+  };
+
+  enum class Extension { NONE, SIGN, ZERO };
+
+  Kind kind{Kind::DIRECT};
+  llvm::Type* coerced_type{nullptr};
+
+  // x86-64 passes memory arguments on stack, then the copy is made by
+  // `byval`, otherwise caller passes pointer to its own copy
+  bool is_byval{false};
+
+  // small integers are extended to 32 bits by caller, like in C
+  Extension extension{Extension::NONE};
+
+  bool is_direct() const { return kind == Kind::DIRECT; }
+  bool is_coerced() const { return kind == Kind::COERCED; }
+  bool is_indirect() const { return kind == Kind::INDIRECT; }
+};
+
+struct FunctionABI {
+  // not used when function returns unit
+  ABIArgInfo result;
+  std::vector<ABIArgInfo> arguments;
+};
+
+// Lowers tea types to C calling convention of the target, so small tuples and
+// classes are passed in registers and extern functions can be implemented in
+// C++. Only integer-like types exist in the language, so floating point
+// classes of ABIs aren't handled.
+class ABIInfo {
+ protected:
+  const llvm::DataLayout& data_layout_;
+  TypesMapper& types_mapper_;
+
+  uint64_t get_size(Type* type) const;
+  ABIArgInfo classify_scalar(Type* type) const;
+
+  virtual ABIArgInfo classify_result(Type* type) const;
+  // registers are taken from `free_registers` when argument fits in them
+  virtual ABIArgInfo classify_argument(Type* type,
+                                       size_t& free_registers) const;
+  virtual size_t get_argument_registers_count() const { return 0; }
+
+ public:
+  ABIInfo(const llvm::DataLayout& data_layout, TypesMapper& types_mapper)
+      : data_layout_(data_layout), types_mapper_(types_mapper) {}
+
+  virtual ~ABIInfo() = default;
+
+  FunctionABI get_function_abi(const FunctionType& type) const;
+
+  // generic lowering is used for targets without specific one, every
+  // aggregate is passed through pointer then
+  static std::unique_ptr<ABIInfo> create(const llvm::Triple& triple,
+                                         const llvm::DataLayout& data_layout,
+                                         TypesMapper& types_mapper);
+};
+}  // namespace Front
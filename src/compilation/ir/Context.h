@@ -16,6 +16,7 @@ namespace Front {
 class Mangler;
 class TypesStorage;
 class TypesMapper;
+class ABIInfo;
 
 struct IRContext {
   llvm::Module& llvm_module;
@@ -24,6 +25,7 @@ struct IRContext {
   StringPool& strings;
   TypesStorage& types;
   TypesMapper& types_mapper;
+  const ABIInfo& abi;
 
   llvm::LLVMContext& get_llvm_context();
 };
@@ -1,6 +1,7 @@
 #include "FunctionDecl.h"
 
 #include <llvm/IR/Module.h>
+#include <llvm/Support/ModRef.h>
 
 #include "compilation/SymbolInfo.h"
 #include "compilation/mangling/Mangler.h"
@@ -8,33 +9,110 @@
 #include "compilation/ir/TypesMapper.h"
 
 namespace Front {
+namespace {
+llvm::Attribute::AttrKind get_extension_attribute(
+    ABIArgInfo::Extension extension) {
+  return extension == ABIArgInfo::Extension::SIGN ? llvm::Attribute::SExt
+                                                  : llvm::Attribute::ZExt;
+}
+
+// Pointers passed to functions written in tea are never captured: language
+// can't take address of variable. Result slot and argument copies are made by
+// caller for one call, so nothing else aliases them. Effects and linkage are
+// known only for functions of this module, see EffectsAnalyzer.
+void add_inferred_attributes(llvm::Function& function,
+                             const FunctionSymbolInfo& info,
+                             const FunctionABI& abi, size_t arguments_offset) {
+  if (info.get_specifiers().is_extern()) {
+    return;
+  }
+
+  bool has_pointer_arguments = arguments_offset != 0;
+  bool writes_arguments = arguments_offset != 0;
+
+  if (arguments_offset != 0) {
+    function.addParamAttr(0, llvm::Attribute::NoAlias);
+    function.addParamAttr(0, llvm::Attribute::NoCapture);
+  }
+
+  for (size_t i = 0; i < abi.arguments.size(); ++i) {
+    const ABIArgInfo& argument_abi = abi.arguments[i];
+    size_t index = i + arguments_offset;
+
+    if (!argument_abi.is_indirect()) {
+      continue;
+    }
+
+    has_pointer_arguments = true;
+    function.addParamAttr(index, llvm::Attribute::NoCapture);
+
+    // byval copy belongs to callee and isn't visible to caller at all
+    if (!argument_abi.is_byval) {
+      function.addParamAttr(index, llvm::Attribute::NoAlias);
+    }
+
+    bool is_written =
+        !info.effects.has_value() || info.effects->written_parameters[i];
+    writes_arguments = writes_arguments || is_written;
+
+    if (!is_written) {
+      function.addParamAttr(index, llvm::Attribute::ReadOnly);
+    }
+  }
+
+  if (info.is_internal) {
+    function.setLinkage(llvm::Function::InternalLinkage);
+  }
+
+  if (!info.effects.has_value() || !info.effects->is_pure) {
+    return;
+  }
+
+  function.setDoesNotThrow();
+
+  if (!has_pointer_arguments) {
+    function.setMemoryEffects(llvm::MemoryEffects::none());
+  } else {
+    function.setMemoryEffects(llvm::MemoryEffects::argMemOnly(
+        writes_arguments ? llvm::ModRefInfo::ModRef : llvm::ModRefInfo::Ref));
+  }
+}
+}  // namespace
 
 IRFunctionDecl IRFunctionDecl::create(IRContext context,
                                       const FunctionSymbolInfo& info) {
   std::string name = context.mangler.mangle(info);
+  FunctionABI abi = context.abi.get_function_abi(*info.type);
+  auto& llvm_context = context.get_llvm_context();
 
   // create new function
   std::vector<llvm::Type*> arguments;
-  bool return_through_arg = !info.type->return_type->is_passed_by_value();
+  Type* ret_ty = info.type->return_type;
+  bool return_through_arg = !ret_ty->is_unit() && abi.result.is_indirect();
   size_t arguments_offset = 0;
   if (return_through_arg) {
     arguments_offset = 1;
-    arguments.push_back(llvm::PointerType::get(context.get_llvm_context(), 0));
+    arguments.push_back(llvm::PointerType::get(llvm_context, 0));
   }
 
-  for (Type* argument_type : info.type->arguments) {
-    if (!argument_type->is_passed_by_value()) {
-      argument_type = context.types.add_pointer(argument_type);
-    }
+  for (size_t i = 0; i < info.type->arguments.size(); ++i) {
+    const ABIArgInfo& argument_abi = abi.arguments[i];
 
-    arguments.emplace_back(context.types_mapper(argument_type));
+    if (argument_abi.is_coerced()) {
+      arguments.push_back(argument_abi.coerced_type);
+    } else if (argument_abi.is_indirect()) {
+      arguments.push_back(llvm::PointerType::get(llvm_context, 0));
+    } else {
+      arguments.push_back(context.types_mapper(info.type->arguments[i]));
+    }
   }
 
-  Type* ret_ty = info.type->return_type;
   llvm::Type* llvm_ret_ty;
 
-  if (ret_ty->is_unit() || !ret_ty->is_passed_by_value()) {
-    llvm_ret_ty = llvm::Type::getVoidTy(context.get_llvm_context());
+  if (ret_ty->is_unit() || return_through_arg) {
+    llvm_ret_ty = llvm::Type::getVoidTy(llvm_context);
+  } else if (abi.result.is_coerced()) {
+    llvm_ret_ty = abi.result.coerced_type;
   } else {
     llvm_ret_ty = context.types_mapper(ret_ty);
   }
@@ -47,12 +125,35 @@ IRFunctionDecl IRFunctionDecl::create(IRContext context,
 
   if (return_through_arg) {
     fun->addParamAttr(
-        0, llvm::Attribute::get(context.get_llvm_context(),
-                                llvm::Attribute::StructRet,
-                                context.types_mapper(info.type->return_type)));
+        0, llvm::Attribute::get(llvm_context, llvm::Attribute::StructRet,
+                                context.types_mapper(ret_ty)));
     fun->getArg(0)->setName("result");
+  } else if (abi.result.extension != ABIArgInfo::Extension::NONE) {
+    fun->addRetAttr(get_extension_attribute(abi.result.extension));
   }
 
+  // attributes of arguments, calls copy them from the callee
+  const llvm::DataLayout& data_layout = context.llvm_module.getDataLayout();
+  for (size_t i = 0; i < abi.arguments.size(); ++i) {
+    const ABIArgInfo& argument_abi = abi.arguments[i];
+    size_t index = i + arguments_offset;
+
+    if (argument_abi.is_byval) {
+      llvm::Type* type = context.types_mapper(info.type->arguments[i]);
+
+      fun->addParamAttr(index,
+                        llvm::Attribute::getWithByValType(llvm_context, type));
+      fun->addParamAttr(index,
+                        llvm::Attribute::getWithAlignment(
+                            llvm_context, data_layout.getABITypeAlign(type)));
+    } else if (argument_abi.extension != ABIArgInfo::Extension::NONE) {
+      fun->addParamAttr(index,
+                        get_extension_attribute(argument_abi.extension));
+    }
+  }
+
+  add_inferred_attributes(*fun, info, abi, arguments_offset);
+
   // set names for arguments
   auto& decl = static_cast<FunctionDecl&>(info.declaration);
   for (size_t i = 0; i < decl.parameters.size(); ++i) {
@@ -60,11 +161,11 @@ IRFunctionDecl IRFunctionDecl::create(IRContext context,
         ->setName(context.strings.get_string(decl.parameters[i]->name));
   }
 
-  return IRFunctionDecl(fun, &info);
+  return IRFunctionDecl(fun, &info, std::move(abi));
 }
 
 bool IRFunctionDecl::return_through_argument() const {
-  return !info_->type->return_type->is_passed_by_value();
+  return !info_->type->return_type->is_unit() && abi_.result.is_indirect();
 }
 
 }  // namespace Front
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ABIInfo.h"
 #include "Context.h"
 
 namespace Front {
@@ -10,16 +11,19 @@ class IRFunctionDecl {
  protected:
   llvm::Function* llvm_function_;
   const FunctionSymbolInfo* info_;
+  FunctionABI abi_;
 
  public:
-  IRFunctionDecl(llvm::Function* llvm_function, const FunctionSymbolInfo* info)
-      : llvm_function_(llvm_function), info_(info) {}
+  IRFunctionDecl(llvm::Function* llvm_function, const FunctionSymbolInfo* info,
+                 FunctionABI abi)
+      : llvm_function_(llvm_function), info_(info), abi_(std::move(abi)) {}
 
   static IRFunctionDecl create(IRContext context,
                                const FunctionSymbolInfo& info);
 
   llvm::Function* get_llvm_function() { return llvm_function_; }
   const FunctionSymbolInfo* get_info() { return info_; }
+  const FunctionABI& get_abi() const { return abi_; }
 
   bool return_through_argument() const;
 };
@@ -2,18 +2,71 @@
 
 namespace Front {
 
-Value IRGenerator::compile_expr(const std::unique_ptr<Expression>& expr) {
+Value IRGenerator::compile_expr(const std::unique_ptr<Expression>& expr,
+                                llvm::Value* destination) {
+  auto constant = module_.constants.find(expr.get());
+  if (constant != module_.constants.end()) {
+    return compile_constant(constant->second, expr->type);
+  }
+
   current_expr_value_ = Value::invalid();
+  destination_ = destination;
   traverse(*expr);
+  destination_ = nullptr;
   assert(current_expr_value_ != Value::invalid() &&
          "Expression value must be calculated.");
   return std::exchange(current_expr_value_, Value::invalid());
 }
 
+Value IRGenerator::compile_constant(const ConstantValue& value, Type* type) {
+  llvm::Constant* constant = get_llvm_constant(value, type);
+
+  if (value.is_integer()) {
+    return Value(constant);
+  }
+
+  // tuples are used through pointers, so folded tuple is placed in read-only
+  // memory and copied from there instead of being stored element by element
+  auto [itr, is_inserted] = constant_globals_.try_emplace(constant, nullptr);
+  if (is_inserted) {
+    itr->second = new llvm::GlobalVariable(
+        *llvm_module_, constant->getType(), /*isConstant=*/true,
+        llvm::GlobalValue::PrivateLinkage, constant, "const");
+    itr->second->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+  }
+
+  Value result;
+
+  result.llvm_value = itr->second;
+  result.has_indirection = true;
+
+  return result;
+}
+
+llvm::Constant* IRGenerator::get_llvm_constant(const ConstantValue& value,
+                                               Type* type) {
+  llvm::Type* llvm_type = types_mapper_(type);
+
+  if (value.is_integer()) {
+    return llvm::ConstantInt::get(llvm_type, value.get_integer());
+  }
+
+  auto* tuple_ty = static_cast<TupleType*>(type->get_original());
+  std::vector<llvm::Constant*> elements;
+
+  for (size_t i = 0; i < tuple_ty->elements.size(); ++i) {
+    elements.push_back(
+        get_llvm_constant(value.get_elements()[i], tuple_ty->elements[i]));
+  }
+
+  return llvm::ConstantStruct::get(llvm::cast<llvm::StructType>(llvm_type),
+                                   elements);
+}
+
 Value IRGenerator::compile_tuple_expression(const TupleExpr& value) {
   Value result;
 
-  result.llvm_value = get_slot(value.type);
+  result.llvm_value = take_destination(value.type);
   result.has_indirection = true;
 
   for (size_t i = 0; i < value.elements.size(); ++i) {
@@ -22,8 +75,10 @@ Value IRGenerator::compile_tuple_expression(const TupleExpr& value) {
 
     llvm::Value* element_ptr = llvm_ir_builder_->CreateGEP(
         types_mapper_(value.type), result.llvm_value, {zero, index});
-    create_store(element_ptr, compile_expr(value.elements[i]),
-                 value.elements[i]->type);
+
+    // nested tuples are constructed in place of element
+    Value element = compile_expr(value.elements[i], element_ptr);
+    create_store(element_ptr, element, value.elements[i]->type);
   }
 
   return result;
@@ -127,7 +182,11 @@ Value IRGenerator::compile_id_expression(const IdExpr& value) {
     result.llvm_value = get_or_insert_function(fun).get_llvm_function();
   } else if (info.is_variable()) {
     const VariableSymbolInfo& var = std::get<VariableSymbolInfo>(info);
-    result.llvm_value = get_local_variable_value(var.get_decl());
+    if (!var.is_global()) {
+      return get_local_variable(var.get_decl());
+    }
+
+    result.llvm_value = get_or_insert_global_variable(var);
   } else {
     unreachable("SemanticAnalyzer must throw if any other type appears here");
   }
@@ -158,33 +217,65 @@ Value IRGenerator::compile_tuple_index_expression(const TupleIndexExpr& value) {
 Value IRGenerator::compile_call_expression(const CallExpr& value) {
   FunctionType* fun_ty = static_cast<FunctionType*>(value.callee->type);
 
+  // operands are compiled with destinations of their own
+  llvm::Value* destination = std::exchange(destination_, nullptr);
+
   Value callee_value = compile_expr(value.callee);
   assert(callee_value.has_indirection);
 
   llvm::Function* llvm_callee =
       llvm::dyn_cast<llvm::Function>(callee_value.llvm_value);
+  FunctionABI abi = abi_info_->get_function_abi(*fun_ty);
   std::vector<llvm::Value*> arguments;
-  bool return_through_arg = !fun_ty->return_type->is_passed_by_value();
+  bool return_through_arg =
+      !fun_ty->return_type->is_unit() && abi.result.is_indirect();
 
   if (return_through_arg) {
-    arguments.push_back(get_slot(fun_ty->return_type));
+    arguments.push_back(destination != nullptr
+                            ? destination
+                            : get_slot(fun_ty->return_type));
   }
 
-  for (auto& argument : value.arguments) {
+  for (size_t i = 0; i < value.arguments.size(); ++i) {
+    auto& argument = value.arguments[i];
+    const ABIArgInfo& argument_abi = abi.arguments[i];
     Type* arg_ty = argument->type->get_original();
-    Value argument_value = compile_expr(argument);
+    Value argument_value;
 
-    if (arg_ty->is_passed_by_value()) {
-      argument_value = remove_indirection(argument_value, arg_ty);
-    } else {
-      assert(argument_value.has_indirection);
+    if (argument_abi.is_direct()) {
+      argument_value = remove_indirection(compile_expr(argument), arg_ty);
+    } else if (argument_abi.is_coerced()) {
+      // aggregate is constructed in slot of coerced type, so loading it
+      // doesn't read past the aggregate
+      llvm::Value* coerced_slot =
+          get_alloca_builder()->CreateAlloca(argument_abi.coerced_type);
+      argument_value = compile_expr(argument, coerced_slot);
 
+      assert(argument_value.has_indirection);
+      create_store(coerced_slot, argument_value, arg_ty);
+
+      argument_value.llvm_value = llvm_ir_builder_->CreateLoad(
+          argument_abi.coerced_type, coerced_slot);
+      argument_value.has_indirection = false;
+    } else if (!argument_abi.is_byval &&
+               module_.moved_values.contains(argument.get())) {
+      // variable isn't used after the call, callee gets its memory
+      argument_value = compile_expr(
+          static_cast<const ImplicitTupleCopyExpr&>(*argument).value);
+      assert(argument_value.has_indirection);
+    } else if (!argument_abi.is_byval) {
       llvm::Value* copy_slot =
           get_alloca_builder()->CreateAlloca(types_mapper_(arg_ty));
+      argument_value = compile_expr(argument, copy_slot);
+
+      assert(argument_value.has_indirection);
       create_store(copy_slot, argument_value, arg_ty);
 
       argument_value.llvm_value = copy_slot;
       argument_value.has_indirection = true;
+    } else {
+      // byval argument is copied by the call itself
+      argument_value = compile_expr(argument);
     }
 
     arguments.push_back(argument_value.llvm_value);
@@ -192,12 +283,20 @@ Value IRGenerator::compile_call_expression(const CallExpr& value) {
 
   Value result;
 
-  llvm::Value* call_result =
+  llvm::CallInst* call_result =
       llvm_ir_builder_->CreateCall(llvm_callee, arguments);
+  call_result->setAttributes(llvm_callee->getAttributes());
 
   if (return_through_arg) {
     result.llvm_value = arguments[0];
     result.has_indirection = true;
+  } else if (abi.result.is_coerced()) {
+    llvm::Value* coerced_slot =
+        get_alloca_builder()->CreateAlloca(abi.result.coerced_type);
+    llvm_ir_builder_->CreateStore(call_result, coerced_slot);
+
+    result.llvm_value = coerced_slot;
+    result.has_indirection = true;
   } else {
     result.llvm_value = call_result;
     result.has_indirection = false;
@@ -4,7 +4,23 @@
 #include <llvm/IR/Type.h>
 #include <llvm/IR/Verifier.h>
 
+#include "profiling/AllocationProfiler.h"
+#include "profiling/Tracer.h"
+
 namespace Front {
+namespace {
+// sizes of aggregates depend on data layout, so it is set before any code is
+// generated
+std::unique_ptr<llvm::Module> create_module(
+    const std::string& name, llvm::LLVMContext& llvm_context,
+    const llvm::TargetMachine& target_machine) {
+  auto module = std::make_unique<llvm::Module>(name, llvm_context);
+  module->setTargetTriple(target_machine.getTargetTriple().str());
+  module->setDataLayout(target_machine.createDataLayout());
+
+  return module;
+}
+}  // namespace
 
 void IRGenerator::create_function_arguments() {
   const FunctionDecl& decl = current_function_->get_info()->get_decl();
@@ -15,15 +31,28 @@ void IRGenerator::create_function_arguments() {
 
     Type* arg_ty = parameter.type->value->get_original();
 
+    const ABIArgInfo& abi = current_function_->get_abi().arguments[i];
     llvm::Value* ptr;
 
-    if (!arg_ty->is_passed_by_value()) {
+    if (abi.is_direct() && is_promotable(parameter)) {
+      get_local_variable(parameter);
+      ssa_builder_.write_variable(parameter,
+                                  llvm_ir_builder_->GetInsertBlock(), llvm_arg);
+      continue;
+    }
+
+    if (abi.is_indirect()) {
       ptr = llvm_arg;
     } else {
       auto name = fmt::format("{}.addr", module_.get_string(decl.name));
 
+      // coerced aggregate is stored as it was passed, its slot is big enough
+      // to be used as the aggregate itself
+      llvm::Type* slot_type =
+          abi.is_coerced() ? abi.coerced_type : types_mapper_(arg_ty);
+
       auto builder = get_alloca_builder();
-      ptr = builder->CreateAlloca(types_mapper_(arg_ty), nullptr, name);
+      ptr = builder->CreateAlloca(slot_type, nullptr, name);
       builder->CreateStore(llvm_arg, ptr);
     }
 
@@ -31,6 +60,31 @@ void IRGenerator::create_function_arguments() {
   }
 }
 
+bool IRGenerator::is_promotable(const VariableDecl& decl) {
+  // there is no operator taking address of variable yet, so every scalar is
+  // promoted. Aggregates are accessed through GEPs and stay in memory
+  Type* type = decl.type->value;
+  return type->is_passed_by_value() && !type->is_unit();
+}
+
+Value IRGenerator::get_local_variable(const VariableDecl& decl) {
+  Value result;
+  result.has_indirection = true;
+
+  if (!is_promotable(decl)) {
+    result.llvm_value = get_local_variable_value(decl);
+    return result;
+  }
+
+  if (!ssa_builder_.is_declared(decl)) {
+    ssa_builder_.declare_variable(decl, types_mapper_(decl.type->value),
+                                  std::string(module_.get_string(decl.name)));
+  }
+
+  result.variable = &decl;
+  return result;
+}
+
 llvm::Value* IRGenerator::get_local_variable_value(const VariableDecl& decl) {
   auto itr = local_variables_.find(&decl);
 
@@ -49,12 +103,43 @@ IRFunctionDecl IRGenerator::get_or_insert_function(
   std::string name = mangler_.mangle(info);
   llvm::Function* function = llvm_module_->getFunction(name);
   if (function != nullptr) {
-    return IRFunctionDecl(function, &info);
+    return IRFunctionDecl(function, &info,
+                          abi_info_->get_function_abi(*info.type));
   }
 
   return IRFunctionDecl::create(get_context(), info);
 }
 
+llvm::GlobalVariable* IRGenerator::get_or_insert_global_variable(
+    const VariableSymbolInfo& info) {
+  std::string name = mangler_.mangle(info);
+  if (llvm::GlobalVariable* variable = llvm_module_->getGlobalVariable(name)) {
+    return variable;
+  }
+
+  // declaration, definition gets initializer and linkage later
+  return new llvm::GlobalVariable(
+      *llvm_module_, types_mapper_(info.type), /*isConstant=*/false,
+      llvm::GlobalValue::ExternalLinkage, /*Initializer=*/nullptr, name);
+}
+
+void IRGenerator::create_global_variable(const VariableDecl& decl,
+                                         const VariableSymbolInfo& info) {
+  llvm::GlobalVariable* variable = get_or_insert_global_variable(info);
+
+  // semantic analyzer checks that initializer is constant
+  llvm::Constant* initializer =
+      decl.initializer != nullptr
+          ? get_llvm_constant(module_.constants.at(decl.initializer.get()),
+                              info.type)
+          : llvm::Constant::getNullValue(variable->getValueType());
+
+  variable->setInitializer(initializer);
+  if (!info.is_visible_outside()) {
+    variable->setLinkage(llvm::GlobalValue::InternalLinkage);
+  }
+}
+
 std::unique_ptr<llvm::IRBuilder<>> IRGenerator::get_alloca_builder() {
   auto temp_builder = std::make_unique<llvm::IRBuilder<>>(llvm_context_);
 
@@ -68,17 +153,27 @@ llvm::Value* IRGenerator::get_slot(Type* type) {
   return get_alloca_builder()->CreateAlloca(types_mapper_(type));
 }
 
+llvm::Value* IRGenerator::take_destination(Type* type) {
+  llvm::Value* destination = std::exchange(destination_, nullptr);
+  return destination != nullptr ? destination : get_slot(type);
+}
+
 IRContext IRGenerator::get_context() {
-  return IRContext{*llvm_module_, mangler_, module_.get_strings_pool(),
-                   module_.types_storage, types_mapper_};
+  return IRContext{*llvm_module_,         mangler_,
+                   module_.get_strings_pool(), module_.types_storage,
+                   types_mapper_,         *abi_info_};
 }
 
-IRGenerator::IRGenerator(llvm::LLVMContext& llvm_context, ModuleContext& module)
+IRGenerator::IRGenerator(llvm::LLVMContext& llvm_context, ModuleContext& module,
+                         const llvm::TargetMachine& target_machine)
     : llvm_context_(llvm_context),
-      llvm_module_(std::make_unique<llvm::Module>(module.name, llvm_context_)),
+      llvm_module_(create_module(module.name, llvm_context, target_machine)),
       llvm_ir_builder_(std::make_unique<llvm::IRBuilder<>>(llvm_context_)),
       module_(module),
       mangler_(module.get_strings_pool()),
+      // ABI info only keeps reference to mapper, so it can be created first
+      abi_info_(ABIInfo::create(target_machine.getTargetTriple(),
+                                llvm_module_->getDataLayout(), types_mapper_)),
       types_mapper_(get_context()) {}
 
 bool IRGenerator::traverse_implicit_lvalue_to_rvalue_conversion_expression(
@@ -99,6 +194,8 @@ bool IRGenerator::traverse_if_statement(const IfStmt& value) {
 
   llvm_ir_builder_->CreateCondBr(condition_value.llvm_value, true_branch,
                                  false_branch);
+  ssa_builder_.seal_block(true_branch);
+  ssa_builder_.seal_block(false_branch);
 
   llvm_ir_builder_->SetInsertPoint(true_branch);
   if (traverse(*value.true_branch)) {
@@ -111,7 +208,9 @@ bool IRGenerator::traverse_if_statement(const IfStmt& value) {
     llvm_ir_builder_->CreateBr(merge);
   }
 
+  // both branches are generated, so all predecessors of merge are known
   current_function->insert(current_function->end(), merge);
+  ssa_builder_.seal_block(merge);
   llvm_ir_builder_->SetInsertPoint(merge);
   return true;
 }
@@ -134,6 +233,8 @@ bool IRGenerator::traverse_while_statement(const WhileStmt& value) {
       remove_indirection(compile_expr(value.condition), value.condition->type);
   llvm_ir_builder_->CreateCondBr(condition_value.llvm_value, loop_block,
                                  after_loop_block);
+  ssa_builder_.seal_block(loop_block);
+  ssa_builder_.seal_block(after_loop_block);
 
   // compile loop body
   llvm_ir_builder_->SetInsertPoint(loop_block);
@@ -141,7 +242,9 @@ bool IRGenerator::traverse_while_statement(const WhileStmt& value) {
     llvm_ir_builder_->CreateBr(condition_block);
   }
 
-  //
+  // back edge is known only after the body
+  ssa_builder_.seal_block(condition_block);
+
   llvm_ir_builder_->SetInsertPoint(after_loop_block);
 
   return true;
@@ -181,21 +284,30 @@ bool IRGenerator::traverse_function_declaration(const FunctionDecl& value) {
   llvm_ir_builder_->SetInsertPoint(alloca_bb);
   llvm::Value* result_ptr;
   bool return_through_arg = decl.return_through_argument();
+  const ABIArgInfo& result_abi = decl.get_abi().result;
+
+  // coerced result is loaded from slot of its coerced type, which is big
+  // enough to hold the aggregate
+  llvm::Type* result_type = result_abi.is_coerced()
+                                ? result_abi.coerced_type
+                                : types_mapper_(value.return_type->value);
 
   if (info.type->return_type->is_unit()) {
     result_ptr = nullptr;
   } else if (return_through_arg) {
     result_ptr = decl.get_llvm_function()->getArg(0);
   } else {
-    result_ptr = llvm_ir_builder_->CreateAlloca(
-        types_mapper_(value.return_type->value), nullptr, "result");
+    result_ptr = llvm_ir_builder_->CreateAlloca(result_type, nullptr, "result");
   }
 
   current_function_ = IRFunction(decl, alloca_bb, return_bb, result_ptr);
 
+  // entry is reached only from block with allocas, arguments are defined in it
+  llvm_ir_builder_->SetInsertPoint(entry_bb);
+  ssa_builder_.seal_block(entry_bb);
+
   create_function_arguments();
 
-  llvm_ir_builder_->SetInsertPoint(entry_bb);
   for (size_t i = 0; i < value.parameters.size(); ++i) {
     VariableDecl& parameter = *value.parameters[i];
     // for now default arguments values are not supported
@@ -219,9 +331,8 @@ bool IRGenerator::traverse_function_declaration(const FunctionDecl& value) {
   if (return_through_arg || info.type->return_type->is_unit()) {
     llvm_ir_builder_->CreateRetVoid();
   } else {
-    auto result =
-        llvm_ir_builder_->CreateLoad(types_mapper_(value.return_type->value),
-                                     current_function_->get_return_value());
+    auto result = llvm_ir_builder_->CreateLoad(
+        result_type, current_function_->get_return_value());
     llvm_ir_builder_->CreateRet(result);
   }
 
@@ -229,6 +340,7 @@ bool IRGenerator::traverse_function_declaration(const FunctionDecl& value) {
 
   // cleanup
   local_variables_.clear();
+  ssa_builder_.clear();
 
   current_function_ = std::nullopt;
 
@@ -236,7 +348,9 @@ bool IRGenerator::traverse_function_declaration(const FunctionDecl& value) {
 }
 
 bool IRGenerator::traverse_return_statement(const ReturnStmt& value) {
-  Value result = compile_expr(value.value);
+  // result is constructed right in the return slot or sret pointer
+  Value result =
+      compile_expr(value.value, current_function_->get_return_value());
   create_store(current_function_->get_return_value(), result,
                value.value->type);
   llvm_ir_builder_->CreateBr(current_function_->get_return_block());
@@ -246,11 +360,27 @@ bool IRGenerator::traverse_return_statement(const ReturnStmt& value) {
 }
 
 bool IRGenerator::traverse_variable_declaration(const VariableDecl& value) {
+  auto global = module_.global_variables_info.find(&value);
+  if (global != module_.global_variables_info.end()) {
+    create_global_variable(value, global->second);
+    return true;
+  }
+
+  if (module_.moved_values.contains(value.initializer.get())) {
+    // source isn't used anymore, so variable takes its memory
+    const auto& copy =
+        static_cast<const ImplicitTupleCopyExpr&>(*value.initializer);
+    local_variables_.emplace(&value, compile_expr(copy.value).llvm_value);
+    return true;
+  }
+
   if (value.initializer != nullptr) {
-    llvm::Value* var_ptr = get_local_variable_value(value);
-    Value initializer_value = compile_expr(value.initializer);
+    Value variable = get_local_variable(value);
+    Value initializer_value = compile_expr(
+        value.initializer,
+        variable.variable == nullptr ? variable.llvm_value : nullptr);
 
-    create_store(var_ptr, initializer_value, value.initializer->type);
+    create_assignment(variable, initializer_value, value.initializer->type);
   }
 
   return true;
@@ -262,7 +392,7 @@ bool IRGenerator::traverse_assignment_statement(const AssignmentStmt& value) {
 
   assert(left_value.has_indirection);
 
-  create_store(left_value.llvm_value, right_value, value.right->type);
+  create_assignment(left_value, right_value, value.right->type);
 
   return true;
 }
@@ -309,6 +439,9 @@ bool IRGenerator::traverse_tuple_index_expression(const TupleIndexExpr& value) {
 }
 
 std::unique_ptr<llvm::Module> IRGenerator::compile() {
+  Profiling::TraceScope trace("IR generation", module_.name);
+  Profiling::AllocationScope allocation_scope(Profiling::AllocationTag::IR);
+
   traverse(*module_.ast_root);
   llvm::verifyModule(*llvm_module_, &llvm::errs());
 
@@ -1,9 +1,12 @@
 #pragma once
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/Module.h>
+#include <llvm/Target/TargetMachine.h>
 
+#include "ABIInfo.h"
 #include "Context.h"
 #include "Function.h"
+#include "SSABuilder.h"
 #include "TypesMapper.h"
 #include "ast/ASTVisitor.h"
 #include "compilation/ModuleContext.h"
@@ -20,13 +23,17 @@ struct Value {
   llvm::Value* llvm_value;
   bool has_indirection;
 
+  // scalar variable in SSA form, it has no address, so it is read and written
+  // through SSABuilder instead of load and store
+  const VariableDecl* variable{nullptr};
+
   Value(llvm::Value* llvm_value)
       : llvm_value(llvm_value), has_indirection(false) {}
 
   Value() : llvm_value(nullptr), has_indirection(false) {}
 
   bool operator==(const Value& other) const {
-    return llvm_value == other.llvm_value;
+    return llvm_value == other.llvm_value && variable == other.variable;
   }
 
   static Value invalid() { return Value(); }
@@ -40,14 +47,24 @@ class IRGenerator : public ASTVisitor<IRGenerator, IRGeneratorConfig> {
   ModuleContext& module_;
 
   Mangler mangler_;
+  // is created before types mapper, because context of mapper refers to it
+  std::unique_ptr<ABIInfo> abi_info_;
   TypesMapper types_mapper_;
 
   // information about current function
   std::unordered_map<const Declaration*, llvm::Value*> local_variables_;
+  SSABuilder ssa_builder_;
 
   std::optional<IRFunction> current_function_{std::nullopt};
 
+  // folded tuples are stored once per module and copied from there
+  std::unordered_map<llvm::Constant*, llvm::GlobalVariable*> constant_globals_;
+
   Value current_expr_value_{Value::invalid()};
+  // memory where outermost expression being compiled may construct its
+  // aggregate instead of temporary slot, it is taken by tuple expression or
+  // call returning through pointer
+  llvm::Value* destination_{nullptr};
 
   // compiler must not pass through some kind of nodes. If it does, then I've
   // made some mistake developing it
@@ -55,24 +72,38 @@ class IRGenerator : public ASTVisitor<IRGenerator, IRGeneratorConfig> {
     unreachable("Compiler doesn't pass through this kind of nodes.");
   }
 
-  Value compile_expr(const std::unique_ptr<Expression>& expr);
+  Value compile_expr(const std::unique_ptr<Expression>& expr,
+                     llvm::Value* destination = nullptr);
+  Value compile_constant(const ConstantValue& value, Type* type);
+  llvm::Constant* get_llvm_constant(const ConstantValue& value, Type* type);
 
   void create_function_arguments();
+  static bool is_promotable(const VariableDecl& decl);
+  Value get_local_variable(const VariableDecl& decl);
   llvm::Value* get_local_variable_value(const VariableDecl& decl);
   IRFunctionDecl get_or_insert_function(const FunctionSymbolInfo& info);
+  llvm::GlobalVariable* get_or_insert_global_variable(
+      const VariableSymbolInfo& info);
+  void create_global_variable(const VariableDecl& decl,
+                              const VariableSymbolInfo& info);
   std::unique_ptr<llvm::IRBuilder<>> get_alloca_builder();
 
   llvm::Value* get_slot(Type* type);
+  llvm::Value* take_destination(Type* type);
 
   IRContext get_context();
 
   void create_store(llvm::Value* destination, Value source, Type* source_type);
+  void create_assignment(Value destination, Value source, Type* source_type);
   void create_tuple_copy_constructor(llvm::Value* destination, Value source,
                                      TupleType* source_type);
   Value remove_indirection(Value value, Type* type);
 
  public:
-  IRGenerator(llvm::LLVMContext& llvm_context, ModuleContext& module);
+  // module is generated for triple and data layout of the machine, calls
+  // follow C ABI of its target
+  IRGenerator(llvm::LLVMContext& llvm_context, ModuleContext& module,
+              const llvm::TargetMachine& target_machine);
 
   // statements
   bool traverse_if_statement(const IfStmt& value);
@@ -9,6 +9,11 @@ void IRGenerator::create_store(llvm::Value* destination, Value source,
   }
 
   if (source_type->get_kind() == Type::Kind::TUPLE) {
+    // value was constructed right in the destination
+    if (source.llvm_value == destination) {
+      return;
+    }
+
     TupleType* tuple_ty = static_cast<TupleType*>(source_type);
     create_tuple_copy_constructor(destination, source, tuple_ty);
   } else if (source_type->is_passed_by_value()) {
@@ -21,6 +26,19 @@ void IRGenerator::create_store(llvm::Value* destination, Value source,
   }
 }
 
+void IRGenerator::create_assignment(Value destination, Value source,
+                                    Type* source_type) {
+  if (destination.variable == nullptr) {
+    create_store(destination.llvm_value, source, source_type);
+    return;
+  }
+
+  source = remove_indirection(source, source_type);
+  ssa_builder_.write_variable(*destination.variable,
+                              llvm_ir_builder_->GetInsertBlock(),
+                              source.llvm_value);
+}
+
 void IRGenerator::create_tuple_copy_constructor(llvm::Value* destination,
                                                 Value source,
                                                 TupleType* source_type) {
@@ -52,8 +70,13 @@ Value IRGenerator::remove_indirection(Value source, Type* type) {
   Value result;
 
   assert(type->is_passed_by_value());
-  result.llvm_value =
-      llvm_ir_builder_->CreateLoad(types_mapper_(type), source.llvm_value);
+  if (source.variable != nullptr) {
+    result.llvm_value = ssa_builder_.read_variable(
+        *source.variable, llvm_ir_builder_->GetInsertBlock());
+  } else {
+    result.llvm_value =
+        llvm_ir_builder_->CreateLoad(types_mapper_(type), source.llvm_value);
+  }
   result.has_indirection = false;
 
   return result;
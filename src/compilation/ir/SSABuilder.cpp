@@ -0,0 +1,145 @@
+#include "SSABuilder.h"
+
+#include <llvm/IR/CFG.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/IRBuilder.h>
+
+#include <cassert>
+
+namespace Front {
+
+void SSABuilder::declare_variable(const VariableDecl& decl, llvm::Type* type,
+                                  std::string name) {
+  variables_.emplace(&decl, Variable{type, std::move(name), {}});
+}
+
+void SSABuilder::write_variable(const VariableDecl& decl,
+                                llvm::BasicBlock* block, llvm::Value* value) {
+  variables_.at(&decl).definitions[block] = value;
+}
+
+llvm::Value* SSABuilder::read_variable(const VariableDecl& decl,
+                                       llvm::BasicBlock* block) {
+  return read_variable(variables_.at(&decl), block);
+}
+
+llvm::Value* SSABuilder::read_variable(Variable& variable,
+                                       llvm::BasicBlock* block) {
+  auto itr = variable.definitions.find(block);
+
+  if (itr != variable.definitions.end()) {
+    if (llvm::Value* value = itr->second) {
+      return value;
+    }
+  }
+
+  return read_variable_recursive(variable, block);
+}
+
+llvm::Value* SSABuilder::read_variable_recursive(Variable& variable,
+                                                 llvm::BasicBlock* block) {
+  llvm::Value* value;
+
+  if (!sealed_blocks_.contains(block)) {
+    // operands are added when block is sealed
+    llvm::PHINode* phi = create_phi(variable, block);
+    incomplete_phis_[block].emplace_back(&variable, phi);
+    value = phi;
+  } else if (llvm::BasicBlock* predecessor = block->getSinglePredecessor()) {
+    value = read_variable(variable, predecessor);
+  } else if (llvm::pred_empty(block)) {
+    // variable is read before initialization or in unreachable code
+    value = llvm::PoisonValue::get(variable.type);
+  } else {
+    // phi is written first to break cycles through loops
+    llvm::PHINode* phi = create_phi(variable, block);
+    variable.definitions[block] = phi;
+    value = add_phi_operands(variable, phi);
+  }
+
+  variable.definitions[block] = value;
+  return value;
+}
+
+llvm::PHINode* SSABuilder::create_phi(Variable& variable,
+                                      llvm::BasicBlock* block) {
+  llvm::IRBuilder<> builder(block, block->begin());
+  return builder.CreatePHI(variable.type, 0, variable.name);
+}
+
+llvm::Value* SSABuilder::add_phi_operands(Variable& variable,
+                                          llvm::PHINode* phi) {
+  for (llvm::BasicBlock* predecessor : llvm::predecessors(phi->getParent())) {
+    phi->addIncoming(read_variable(variable, predecessor), predecessor);
+  }
+
+  return try_remove_trivial_phi(phi);
+}
+
+llvm::Value* SSABuilder::try_remove_trivial_phi(llvm::PHINode* phi) {
+  llvm::Value* same = nullptr;
+
+  for (llvm::Value* operand : phi->incoming_values()) {
+    if (operand == same || operand == phi) {
+      continue;
+    }
+
+    // phi merges at least two values
+    if (same != nullptr) {
+      return phi;
+    }
+
+    same = operand;
+  }
+
+  if (same == nullptr) {
+    same = llvm::PoisonValue::get(phi->getType());
+  }
+
+  std::vector<llvm::WeakVH> phi_users;
+  for (llvm::User* user : phi->users()) {
+    if (user != phi && llvm::isa<llvm::PHINode>(user)) {
+      phi_users.emplace_back(user);
+    }
+  }
+
+  phi->replaceAllUsesWith(same);
+  phi->eraseFromParent();
+
+  // `same` itself may become trivial and be replaced by users below
+  llvm::WeakTrackingVH result = same;
+
+  // users might become trivial too
+  for (llvm::WeakVH& user : phi_users) {
+    if (auto* user_phi = llvm::dyn_cast_or_null<llvm::PHINode>(user)) {
+      try_remove_trivial_phi(user_phi);
+    }
+  }
+
+  return result;
+}
+
+void SSABuilder::seal_block(llvm::BasicBlock* block) {
+  sealed_blocks_.insert(block);
+
+  auto itr = incomplete_phis_.find(block);
+  if (itr == incomplete_phis_.end()) {
+    return;
+  }
+
+  auto phis = std::move(itr->second);
+  incomplete_phis_.erase(itr);
+
+  for (auto [variable, phi] : phis) {
+    add_phi_operands(*variable, phi);
+  }
+}
+
+void SSABuilder::clear() {
+  assert(incomplete_phis_.empty() && "All blocks must be sealed.");
+
+  variables_.clear();
+  sealed_blocks_.clear();
+}
+
+}  // namespace Front
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <llvm/IR/BasicBlock.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/ValueHandle.h>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Front {
+
+struct VariableDecl;
+
+// Builds SSA form for local variables while IR is generated, without allocas
+// and mem2reg (Braun et al., "Simple and Efficient Construction of Static
+// Single Assignment Form").
+// Values of variables are tracked per basic block, phis are placed lazily when
+// a variable is read in block with several predecessors. Block must be sealed
+// once all its predecessors are known, until then phis in it stay incomplete.
+class SSABuilder {
+  struct Variable {
+    llvm::Type* type;
+    std::string name;
+
+    // handles follow replacement of trivial phis
+    std::unordered_map<llvm::BasicBlock*, llvm::WeakTrackingVH> definitions;
+  };
+
+  std::unordered_map<const VariableDecl*, Variable> variables_;
+
+  std::unordered_set<llvm::BasicBlock*> sealed_blocks_;
+  std::unordered_map<llvm::BasicBlock*,
+                     std::vector<std::pair<Variable*, llvm::PHINode*>>>
+      incomplete_phis_;
+
+  llvm::Value* read_variable(Variable& variable, llvm::BasicBlock* block);
+  llvm::Value* read_variable_recursive(Variable& variable,
+                                       llvm::BasicBlock* block);
+
+  llvm::PHINode* create_phi(Variable& variable, llvm::BasicBlock* block);
+  llvm::Value* add_phi_operands(Variable& variable, llvm::PHINode* phi);
+  llvm::Value* try_remove_trivial_phi(llvm::PHINode* phi);
+
+ public:
+  bool is_declared(const VariableDecl& decl) const {
+    return variables_.contains(&decl);
+  }
+
+  void declare_variable(const VariableDecl& decl, llvm::Type* type,
+                        std::string name);
+
+  void write_variable(const VariableDecl& decl, llvm::BasicBlock* block,
+                      llvm::Value* value);
+
+  // value of variable at the end of block, poison if it isn't initialized
+  llvm::Value* read_variable(const VariableDecl& decl, llvm::BasicBlock* block);
+
+  void seal_block(llvm::BasicBlock* block);
+
+  // forgets variables of the finished function, all its blocks must be sealed
+  void clear();
+};
+
+}  // namespace Front
@@ -12,6 +12,8 @@ class TypesMapper {
   explicit TypesMapper(IRContext context) : context_(context) {}
 
   llvm::Type* operator()(Type* type);
+
+  llvm::LLVMContext& get_llvm_context() { return context_.get_llvm_context(); }
 };
 
 }  // namespace Front
@@ -189,6 +189,16 @@ std::string Mangler::mangle(const SymbolInfo& symbol) {
     return result;
   }
 
+  if (symbol.is_variable()) {
+    // like in C++, variables in global scope aren't mangled, others are
+    // encoded by their name only
+    if (qualified_name.parts.size() == 1) {
+      return std::string(strings_.get_string(qualified_name.parts.front()));
+    }
+
+    return "_Z" + mangle_name(qualified_name);
+  }
+
   not_implemented();
 }
 
@@ -9,11 +9,11 @@ bool SemanticAnalyzer::traverse_class_declaration(ClassDecl& node) {
   auto qualified_name = info.get_fully_qualified_name();
   info.type = types().make_type<ClassType>(std::move(qualified_name));
 
-  auto [itr, was_emplaced] = current_scope_->symbols.emplace(node.name, info);
+  SymbolInfo& symbol = current_scope_->add_symbol(node.name, info);
 
-  subscope->parent_symbol = &itr->second;
+  subscope->parent_symbol = &symbol;
   if (node.specifiers.is_exported()) {
-    context_.exported_symbols.push_back(itr->second);
+    context_.exported_symbols.push_back(symbol);
   }
 
   NestedScopeRAII scope_guard(*this, *subscope);
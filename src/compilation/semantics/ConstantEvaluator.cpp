@@ -0,0 +1,193 @@
+#include "ConstantEvaluator.h"
+
+#include "SemanticAnalyzer.h"
+#include "profiling/Tracer.h"
+
+namespace Front {
+namespace {
+size_t get_width(const Type* type) {
+  return static_cast<const PrimitiveType*>(type->get_original())->width;
+}
+
+uint64_t truncate(uint64_t bits, size_t width) {
+  if (width >= 64) {
+    return bits;
+  }
+
+  return bits & ((uint64_t{1} << width) - 1);
+}
+
+int64_t sign_extend(uint64_t bits, size_t width) {
+  if (width >= 64) {
+    return static_cast<int64_t>(bits);
+  }
+
+  size_t shift = 64 - width;
+  return static_cast<int64_t>(bits << shift) >> shift;
+}
+}  // namespace
+
+const ConstantValue* ConstantEvaluator::get_constant(
+    const Expression& node) const {
+  auto itr = context_.constants.find(&node);
+  return itr == context_.constants.end() ? nullptr : &itr->second;
+}
+
+void ConstantEvaluator::fold(const Expression& node, ConstantValue value) {
+  context_.constants.insert_or_assign(&node, std::move(value));
+}
+
+void ConstantEvaluator::drop(const Expression& operand) {
+  context_.constants.erase(&operand);
+}
+
+bool ConstantEvaluator::visit_integer_literal(const IntegerLiteral& node) {
+  auto bits = static_cast<uint64_t>(node.value);
+  fold(node, {truncate(bits, get_width(node.type))});
+  return true;
+}
+
+bool ConstantEvaluator::visit_bool_literal(const BoolLiteral& node) {
+  fold(node, {uint64_t{node.value}});
+  return true;
+}
+
+bool ConstantEvaluator::visit_binary_operator(const BinaryOperator& node) {
+  const ConstantValue* left = get_constant(*node.left);
+  const ConstantValue* right = get_constant(*node.right);
+
+  if (left == nullptr || right == nullptr || !left->is_integer() ||
+      !right->is_integer()) {
+    return true;
+  }
+
+  uint64_t lhs = left->get_integer();
+  uint64_t rhs = right->get_integer();
+
+  // comparisons are signed for all types, same as in IR
+  size_t operands_width = get_width(node.left->type);
+  int64_t signed_lhs = sign_extend(lhs, operands_width);
+  int64_t signed_rhs = sign_extend(rhs, operands_width);
+
+  uint64_t result;
+  switch (node.op_type) {
+    case BinaryOperator::OpType::PLUS:
+      result = lhs + rhs;
+      break;
+    case BinaryOperator::OpType::MINUS:
+      result = lhs - rhs;
+      break;
+    case BinaryOperator::OpType::MULTIPLY:
+      result = lhs * rhs;
+      break;
+    case BinaryOperator::OpType::REMAINDER:
+      // it is undefined behaviour at runtime, instruction is kept
+      if (rhs == 0) {
+        return true;
+      }
+      result = lhs % rhs;
+      break;
+    case BinaryOperator::OpType::LESS:
+      result = signed_lhs < signed_rhs;
+      break;
+    case BinaryOperator::OpType::GREATER:
+      result = signed_lhs > signed_rhs;
+      break;
+    case BinaryOperator::OpType::LESS_EQ:
+      result = signed_lhs <= signed_rhs;
+      break;
+    case BinaryOperator::OpType::GREATER_EQ:
+      result = signed_lhs >= signed_rhs;
+      break;
+    case BinaryOperator::OpType::EQUALEQUAL:
+      result = lhs == rhs;
+      break;
+    case BinaryOperator::OpType::NOTEQUAL:
+      result = lhs != rhs;
+      break;
+    default:
+      unreachable("All binary operator types handled above.");
+  }
+
+  fold(node, {truncate(result, get_width(node.type))});
+  drop(*node.left);
+  drop(*node.right);
+
+  return true;
+}
+
+bool ConstantEvaluator::visit_unary_operator(const UnaryOperator& node) {
+  const ConstantValue* value = get_constant(*node.value);
+
+  if (value == nullptr || node.op_type != UnaryOperator::OpType::NOT) {
+    return true;
+  }
+
+  fold(node, {value->get_integer() ^ 1});
+  drop(*node.value);
+
+  return true;
+}
+
+bool ConstantEvaluator::visit_tuple_expression(const TupleExpr& node) {
+  // unit has no value to fold
+  if (node.elements.empty()) {
+    return true;
+  }
+
+  std::vector<ConstantValue> elements;
+  for (auto& element : node.elements) {
+    const ConstantValue* value = get_constant(*element);
+    if (value == nullptr) {
+      return true;
+    }
+
+    elements.push_back(*value);
+  }
+
+  fold(node, {std::move(elements)});
+  for (auto& element : node.elements) {
+    drop(*element);
+  }
+
+  return true;
+}
+
+bool ConstantEvaluator::visit_tuple_index_expression(
+    const TupleIndexExpr& node) {
+  const ConstantValue* tuple = get_constant(*node.left);
+
+  if (tuple == nullptr) {
+    return true;
+  }
+
+  ConstantValue element = tuple->get_elements()[node.index];
+  fold(node, std::move(element));
+  drop(*node.left);
+
+  return true;
+}
+
+bool ConstantEvaluator::visit_variable_declaration(const VariableDecl& node) {
+  if (node.initializer == nullptr ||
+      !context_.global_variables_info.contains(&node)) {
+    return true;
+  }
+
+  if (get_constant(*node.initializer) == nullptr) {
+    throw SemanticAnalyzerException(
+        {{node.source_range,
+          "Initializer of global variable must be a constant expression."}});
+  }
+
+  return true;
+}
+
+void ConstantEvaluator::evaluate() {
+  OSO_FIRE();
+
+  Profiling::TraceScope trace("constant evaluation", context_.name);
+
+  traverse(*context_.ast_root);
+}
+}  // namespace Front
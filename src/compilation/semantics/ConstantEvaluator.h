@@ -0,0 +1,45 @@
+#pragma once
+
+#include "ast/ASTVisitor.h"
+#include "compilation/ModuleContext.h"
+#include "utils/OneShotObject.h"
+
+namespace Front {
+struct ConstantEvaluatorConfig : ASTVisitorConfig {
+  static constexpr auto order() { return Order::POSTORDER; }
+  static constexpr auto is_const() { return true; }
+  static constexpr auto override_all() { return false; }
+};
+
+// Folds expressions built only of literals, operators and tuples, IR generator
+// emits their values as constants. Arithmetic wraps around width of type,
+// comparisons and remainder follow instructions that IR generator emits for
+// them, so folding never changes behaviour of program.
+// Initializers of global variables must be constant, they are initialized
+// statically.
+class ConstantEvaluator
+    : public ASTVisitor<ConstantEvaluator, ConstantEvaluatorConfig>,
+      OneShotObject {
+  ModuleContext& context_;
+
+  const ConstantValue* get_constant(const Expression& node) const;
+
+  void fold(const Expression& node, ConstantValue value);
+  // operands of folded expression are dropped, so only the largest constant
+  // expressions are kept
+  void drop(const Expression& operand);
+
+ public:
+  explicit ConstantEvaluator(ModuleContext& context) : context_(context) {}
+
+  bool visit_integer_literal(const IntegerLiteral& node);
+  bool visit_bool_literal(const BoolLiteral& node);
+  bool visit_binary_operator(const BinaryOperator& node);
+  bool visit_unary_operator(const UnaryOperator& node);
+  bool visit_tuple_expression(const TupleExpr& node);
+  bool visit_tuple_index_expression(const TupleIndexExpr& node);
+  bool visit_variable_declaration(const VariableDecl& node);
+
+  void evaluate();
+};
+}  // namespace Front
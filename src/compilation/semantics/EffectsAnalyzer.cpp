@@ -0,0 +1,148 @@
+#include "EffectsAnalyzer.h"
+
+#include "profiling/Tracer.h"
+#include "utils/Constants.h"
+
+namespace Front {
+FunctionSymbolInfo* EffectsAnalyzer::get_local_function(
+    const Expression& callee) {
+  if (callee.get_kind() != ASTNode::Kind::ID_EXPR) {
+    return nullptr;
+  }
+
+  SymbolInfo& symbol =
+      context_.symbols_info.at(&static_cast<const IdExpr&>(callee));
+  auto* function = std::get_if<FunctionSymbolInfo>(&symbol);
+
+  // imported functions are injected as copies with declarations from other
+  // modules, so they aren't found here
+  if (function == nullptr ||
+      !context_.functions_info.contains(&function->get_decl()) ||
+      function->get_specifiers().is_extern()) {
+    return nullptr;
+  }
+
+  return function;
+}
+
+bool EffectsAnalyzer::visit_call_expression(const CallExpr& node) {
+  FunctionSymbolInfo* callee = get_local_function(*node.callee);
+
+  if (callee == nullptr) {
+    current_->touches_unknown = true;
+  } else {
+    current_->callees.insert(callee);
+  }
+
+  return true;
+}
+
+bool EffectsAnalyzer::visit_id_expression(const IdExpr& node) {
+  SymbolInfo& symbol = context_.symbols_info.at(&node);
+  auto* variable = std::get_if<VariableSymbolInfo>(&symbol);
+
+  if (variable != nullptr && variable->is_global()) {
+    current_->touches_unknown = true;
+  }
+
+  return true;
+}
+
+bool EffectsAnalyzer::visit_assignment_statement(const AssignmentStmt& node) {
+  // find variable whose memory is written
+  const Expression* left = node.left.get();
+  while (true) {
+    if (left->get_kind() == ASTNode::Kind::TUPLE_INDEX_EXPR) {
+      left = static_cast<const TupleIndexExpr*>(left)->left.get();
+    } else if (left->get_kind() == ASTNode::Kind::MEMBER_EXPR) {
+      left = static_cast<const MemberExpr*>(left)->left.get();
+    } else {
+      break;
+    }
+  }
+
+  if (left->get_kind() != ASTNode::Kind::ID_EXPR) {
+    return true;
+  }
+
+  SymbolInfo& symbol =
+      context_.symbols_info.at(static_cast<const IdExpr*>(left));
+  if (!symbol.is_variable()) {
+    return true;
+  }
+
+  const Declaration* variable = &symbol.get_declaration();
+  const FunctionDecl& function = current_->info->get_decl();
+  FunctionEffects& effects = *current_->info->effects;
+
+  for (size_t i = 0; i < function.parameters.size(); ++i) {
+    if (function.parameters[i].get() == variable) {
+      effects.written_parameters[i] = true;
+    }
+  }
+
+  return true;
+}
+
+void EffectsAnalyzer::analyze() {
+  OSO_FIRE();
+
+  Profiling::TraceScope trace("effects analysis", context_.name);
+
+  std::vector<FunctionNode> functions;
+
+  for (auto& [decl, info_ref] : context_.functions_info) {
+    FunctionSymbolInfo& info = info_ref.get();
+
+    // main is looked up by name when program is linked or run
+    bool is_entrypoint =
+        info.get_fully_qualified_name().parts.size() == 1 &&
+        context_.get_string(decl->name) == Constants::entrypoint;
+
+    info.is_internal = !decl->specifiers.is_extern() && !is_entrypoint &&
+                       !info.is_visible_outside();
+
+    if (decl->specifiers.is_extern()) {
+      continue;
+    }
+
+    info.effects = FunctionEffects{
+        .is_pure = true,
+        .written_parameters = std::vector<bool>(decl->parameters.size())};
+    functions.push_back(FunctionNode{.info = &info});
+  }
+
+  for (FunctionNode& function : functions) {
+    current_ = &function;
+
+    for (auto& stmt : function.info->get_decl().body->statements) {
+      traverse(*stmt);
+    }
+  }
+
+  current_ = nullptr;
+
+  // every function is pure at first, impurity spreads to callers
+  bool is_changed = true;
+  while (is_changed) {
+    is_changed = false;
+
+    for (FunctionNode& function : functions) {
+      FunctionEffects& effects = *function.info->effects;
+      if (!effects.is_pure) {
+        continue;
+      }
+
+      bool is_pure = !function.touches_unknown;
+      for (FunctionSymbolInfo* callee : function.callees) {
+        is_pure = is_pure && callee->effects->is_pure;
+      }
+
+      if (!is_pure) {
+        effects.is_pure = false;
+        is_changed = true;
+      }
+    }
+  }
+}
+}  // namespace Front
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <unordered_set>
+
+#include "ast/ASTVisitor.h"
+#include "compilation/ModuleContext.h"
+#include "utils/OneShotObject.h"
+
+namespace Front {
+struct EffectsAnalyzerConfig : ASTVisitorConfig {
+  static constexpr auto order() { return Order::PREORDER; }
+  static constexpr auto is_const() { return true; }
+  static constexpr auto override_all() { return false; }
+};
+
+// Infers effects and linkage of functions defined in the module, IR generator
+// turns them into LLVM attributes.
+// There is no way to take address of variable, so function can touch memory
+// outside of its arguments and locals (or unwind) only by accessing global
+// variables or by calling code that isn't known here: extern functions and
+// functions of other modules. Function is pure when neither it nor its
+// transitive callees do so, recursion is resolved by optimistic fixed point.
+class EffectsAnalyzer
+    : public ASTVisitor<EffectsAnalyzer, EffectsAnalyzerConfig>,
+      OneShotObject {
+  ModuleContext& context_;
+
+  struct FunctionNode {
+    FunctionSymbolInfo* info;
+    std::unordered_set<FunctionSymbolInfo*> callees;
+    // accesses globals or calls unknown code
+    bool touches_unknown{false};
+  };
+
+  // function whose body is traversed
+  FunctionNode* current_{nullptr};
+
+  FunctionSymbolInfo* get_local_function(const Expression& callee);
+
+ public:
+  explicit EffectsAnalyzer(ModuleContext& context) : context_(context) {}
+
+  bool visit_call_expression(const CallExpr& node);
+  bool visit_id_expression(const IdExpr& node);
+  bool visit_assignment_statement(const AssignmentStmt& node);
+
+  void analyze();
+};
+}  // namespace Front
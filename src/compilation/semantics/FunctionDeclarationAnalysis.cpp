@@ -3,7 +3,7 @@
 namespace Front {
 bool SemanticAnalyzer::traverse_function_declaration(FunctionDecl& node) {
   Scope& scope = *current_scope_;
-  if (scope.has_symbol(node.name)) {
+  if (has_symbol(scope, node.name)) {
     auto name = context_.get_string(node.name);
     scold_user(
         node,
@@ -0,0 +1,73 @@
+#include "LastUseAnalyzer.h"
+
+#include "profiling/Tracer.h"
+
+namespace Front {
+bool LastUseAnalyzer::traverse_while_statement(const WhileStmt& node) {
+  // condition is evaluated on every iteration too
+  ++loop_depth_;
+  bool result = traverse(*node.condition) && traverse(*node.body);
+  --loop_depth_;
+
+  return result;
+}
+
+bool LastUseAnalyzer::visit_variable_declaration(const VariableDecl& node) {
+  declaration_depths_.emplace(&node, loop_depth_);
+  return true;
+}
+
+bool LastUseAnalyzer::visit_implicit_tuple_copy_expression(
+    const ImplicitTupleCopyExpr& node) {
+  current_copy_ = &node;
+  return true;
+}
+
+bool LastUseAnalyzer::visit_id_expression(const IdExpr& node) {
+  SymbolInfo& symbol = context_.symbols_info.at(&node);
+  auto* variable = std::get_if<VariableSymbolInfo>(&symbol);
+
+  // parameters and globals aren't declared in function body
+  if (variable == nullptr ||
+      !declaration_depths_.contains(&variable->get_decl())) {
+    return true;
+  }
+
+  const ImplicitTupleCopyExpr* copy =
+      current_copy_ != nullptr && current_copy_->value.get() == &node
+          ? current_copy_
+          : nullptr;
+
+  last_uses_.insert_or_assign(&variable->get_decl(),
+                              Use{.copy = copy, .loop_depth = loop_depth_});
+
+  return true;
+}
+
+void LastUseAnalyzer::analyze() {
+  OSO_FIRE();
+
+  Profiling::TraceScope trace("last use analysis", context_.name);
+
+  for (auto& [decl, info] : context_.functions_info) {
+    if (decl->specifiers.is_extern()) {
+      continue;
+    }
+
+    for (auto& stmt : decl->body->statements) {
+      traverse(*stmt);
+    }
+
+    for (auto& [variable, use] : last_uses_) {
+      if (use.copy != nullptr &&
+          use.loop_depth == declaration_depths_.at(variable)) {
+        context_.moved_values.insert(use.copy);
+      }
+    }
+
+    declaration_depths_.clear();
+    last_uses_.clear();
+    current_copy_ = nullptr;
+  }
+}
+}  // namespace Front
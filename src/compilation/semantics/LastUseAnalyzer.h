@@ -0,0 +1,52 @@
+#pragma once
+
+#include <unordered_map>
+
+#include "ast/ASTVisitor.h"
+#include "compilation/ModuleContext.h"
+#include "utils/OneShotObject.h"
+
+namespace Front {
+struct LastUseAnalyzerConfig : ASTVisitorConfig {
+  static constexpr auto order() { return Order::PREORDER; }
+  static constexpr auto is_const() { return true; }
+  static constexpr auto override_all() { return false; }
+};
+
+// Finds copies of local tuples that are the last use of variable, IR
+// generator moves them: initialized variable or argument takes memory of the
+// source instead of copying it.
+// Use is the last one when no other use follows it in the function body and
+// there is no loop between it and declaration of variable, so it can't be
+// executed twice. Parameters aren't moved, their memory stays readonly when
+// callee doesn't write it.
+class LastUseAnalyzer
+    : public ASTVisitor<LastUseAnalyzer, LastUseAnalyzerConfig>,
+      OneShotObject {
+  ModuleContext& context_;
+
+  struct Use {
+    // copy of the variable, if it is the use
+    const ImplicitTupleCopyExpr* copy;
+    size_t loop_depth;
+  };
+
+  size_t loop_depth_{0};
+  const ImplicitTupleCopyExpr* current_copy_{nullptr};
+
+  // local variables of current function
+  std::unordered_map<const VariableDecl*, size_t> declaration_depths_;
+  std::unordered_map<const VariableDecl*, Use> last_uses_;
+
+ public:
+  explicit LastUseAnalyzer(ModuleContext& context) : context_(context) {}
+
+  bool traverse_while_statement(const WhileStmt& node);
+
+  bool visit_variable_declaration(const VariableDecl& node);
+  bool visit_implicit_tuple_copy_expression(const ImplicitTupleCopyExpr& node);
+  bool visit_id_expression(const IdExpr& node);
+
+  void analyze();
+};
+}  // namespace Front
@@ -2,48 +2,135 @@
 
 namespace Front {
 
-void SemanticAnalyzer::inject_symbol(ModuleContext& module,
-                                     SymbolInfo& symbol) {
+std::optional<QualifiedId> SemanticAnalyzer::get_namespace_path(
+    const Scope& scope) {
+  QualifiedId result;
+  const Scope* current_scope = &scope;
+
+  // scope is a namespace if it is a subscope of namespace symbol in its parent
+  while (current_scope->parent != nullptr) {
+    auto itr = current_scope->parent->symbols.find(current_scope->name);
+    if (itr == current_scope->parent->symbols.end()) {
+      return std::nullopt;
+    }
+
+    auto* info = std::get_if<NamespaceSymbolInfo>(&itr->second);
+    if (info == nullptr || info->subscope != current_scope) {
+      return std::nullopt;
+    }
+
+    result.parts.push_back(current_scope->name);
+    current_scope = current_scope->parent;
+  }
+
+  std::ranges::reverse(result.parts);
+  return result;
+}
+
+void SemanticAnalyzer::add_import(QualifiedId path, ImportedSymbol imported) {
+  auto& entries = imports_[std::move(path)];
+
+  for (ImportedSymbol& entry : entries) {
+    if (entry.symbol == imported.symbol) {
+      entry.is_only_path &= imported.is_only_path;
+      return;
+    }
+
+    // only namespaces from different modules can be merged
+    if (!entry.symbol->is_namespace() || !imported.symbol->is_namespace()) {
+      scold_user(entry.symbol->get_declaration(),
+                 "name is conflicting with name from module {:?}",
+                 imported.module->name);
+    }
+  }
+
+  entries.push_back(imported);
+}
+
+void SemanticAnalyzer::add_import(ModuleContext& module, SymbolInfo& symbol) {
   const StringPool& external_strings = module.get_strings_pool();
 
-  QualifiedId external_qualified_path = symbol.get_fully_qualified_name();
-  StringId external_name = external_qualified_path.pop_name();
+  QualifiedId external_path = symbol.get_fully_qualified_name();
+  QualifiedId local_path =
+      import_external_string(external_path, external_strings);
+
+  // namespaces that lead to the symbol are imported too, but their other
+  // members stay invisible
   Scope* external_scope = module.root_scope.get();
+  QualifiedId local_prefix;
+
+  for (size_t i = 0; i + 1 < external_path.parts.size(); ++i) {
+    SymbolInfo& external_namespace =
+        external_scope->symbols.at(external_path.parts[i]);
+    local_prefix.parts.push_back(local_path.parts[i]);
+
+    add_import(local_prefix, {&module, &external_namespace, true});
+    external_scope = std::get<NamespaceSymbolInfo>(external_namespace).subscope;
+  }
+
+  add_import(std::move(local_path), {&module, &symbol, false});
+}
+
+void SemanticAnalyzer::inject_imported(Scope& scope, StringId name) {
+  if (imports_.empty()) {
+    return;
+  }
+
+  std::optional<QualifiedId> path = get_namespace_path(scope);
+  if (!path) {
+    return;
+  }
+
+  path->parts.push_back(name);
+
+  auto itr = imports_.find(*path);
+  if (itr == imports_.end()) {
+    return;
+  }
+
+  // entry is removed before injection, because injection of namespace adds
+  // new entries into the table
+  std::vector<ImportedSymbol> entries = std::move(itr->second);
+  imports_.erase(itr);
 
-  auto local_qualified_path =
-      import_external_string(external_qualified_path, external_strings);
-  StringId local_name = import_external_string(external_name, external_strings);
-  Scope* local_scope = context_.root_scope.get();
-
-  size_t path_size = external_qualified_path.parts.size();
-
-  for (size_t i = 0; i < path_size; ++i) {
-    StringId external_part = external_qualified_path.parts[i];
-    StringId local_part = local_qualified_path.parts[i];
-
-    NamespaceSymbolInfo& external_namespace = std::get<NamespaceSymbolInfo>(
-        external_scope->symbols.at(external_part));
-
-    auto itr = local_scope->symbols.find(local_part);
-    if (itr == local_scope->symbols.end()) {
-      Scope* subscope = &local_scope->add_child(local_part);
-      local_scope->add_namespace(local_part, external_namespace.declaration,
-                                 subscope);
-
-      local_scope = subscope;
-    } else if (!std::holds_alternative<NamespaceSymbolInfo>(itr->second)) {
-      throw std::runtime_error("Error!");
-    } else {
-      NamespaceSymbolInfo& local_namespace =
-          std::get<NamespaceSymbolInfo>(itr->second);
-      local_scope = local_namespace.subscope;
+  for (const ImportedSymbol& entry : entries) {
+    inject_symbol(scope, name, entry);
+  }
+}
+
+bool SemanticAnalyzer::has_symbol(Scope& scope, StringId name) {
+  inject_imported(scope, name);
+  return scope.has_symbol(name);
+}
+
+void SemanticAnalyzer::inject_symbol(Scope& local_scope, StringId local_name,
+                                     const ImportedSymbol& imported) {
+  ModuleContext& module = *imported.module;
+  const StringPool& external_strings = module.get_strings_pool();
+
+  auto itr = local_scope.symbols.find(local_name);
+
+  if (auto* nmsp = std::get_if<NamespaceSymbolInfo>(imported.symbol)) {
+    if (itr == local_scope.symbols.end()) {
+      Scope* subscope = &local_scope.add_child(local_name);
+      local_scope.add_namespace(local_name, nmsp->declaration, subscope);
+    } else if (!itr->second.is_namespace()) {
+      scold_user(itr->second.get_declaration(),
+                 "name is conflicting with name from module {:?}",
+                 module.name);
+    }
+
+    // members of exported namespace become visible one by one on lookup
+    if (!imported.is_only_path) {
+      for (auto& nmsp_symbol : nmsp->subscope->symbols) {
+        add_import(module, nmsp_symbol.second);
+      }
     }
 
-    external_scope = external_namespace.subscope;
+    return;
   }
 
-  auto itr = local_scope->symbols.find(local_name);
-  if (itr != local_scope->symbols.end()) {
+  if (itr != local_scope.symbols.end()) {
     Declaration& decl = itr->second.get_declaration();
     scold_user(decl, "name is conflicting with name from module {:?}",
                module.name);
@@ -53,35 +140,33 @@ void SemanticAnalyzer::inject_symbol(ModuleContext& module,
       Overloaded{
           [&](const VariableSymbolInfo& var) {
             Type* var_ty = inject_type(var.type, external_strings);
-            local_scope->add_variable(local_name, var.declaration, var_ty);
+            local_scope.add_variable(local_name, var.declaration, var_ty);
           },
-          [&](const NamespaceSymbolInfo& nmsp) {
-            for (auto& nmsp_symbol : nmsp.subscope->symbols) {
-              inject_symbol(module, nmsp_symbol.second);
-            }
+          [&](const NamespaceSymbolInfo&) {
+            unreachable("namespaces are handled above");
           },
           [&](const FunctionSymbolInfo& fun) {
             Type* fun_ty = inject_type(fun.type, external_strings);
-            local_scope->add_function(local_name, fun.declaration,
-                                      static_cast<FunctionType*>(fun_ty),
-                                      fun.subscope);
+            local_scope.add_function(local_name, fun.declaration,
+                                     static_cast<FunctionType*>(fun_ty),
+                                     fun.subscope);
           },
           [&](const TypeAliasSymbolInfo& alias) {
             AliasType* alias_ty = static_cast<AliasType*>(
                 inject_type(alias.type, external_strings));
-            local_scope->symbols.emplace(
+            local_scope.add_symbol(
                 local_name,
-                TypeAliasSymbolInfo{local_scope, alias.declaration, alias_ty});
+                TypeAliasSymbolInfo{&local_scope, alias.declaration, alias_ty});
           },
           [&](const ClassSymbolInfo& cls) {
             ClassType* cls_ty = static_cast<ClassType*>(
                 inject_type(cls.type, external_strings));
             auto cls_info =
-                ClassSymbolInfo{local_scope, cls.subscope, cls.declaration};
+                ClassSymbolInfo{&local_scope, cls.subscope, cls.declaration};
             cls_info.type = cls_ty;
-            local_scope->symbols.emplace(local_name, cls_info);
+            local_scope.add_symbol(local_name, cls_info);
           }},
-      symbol);
+      *imported.symbol);
 }
 
 Type* SemanticAnalyzer::inject_type(Type* external_type,
@@ -147,10 +232,25 @@ Type* SemanticAnalyzer::inject_type(Type* external_type,
 }
 
 SymbolInfo* SemanticAnalyzer::name_lookup(Scope* scope, const QualifiedId& id) {
+  NameLookupCache& cache = context_.name_lookup_cache;
+
+  std::optional<SymbolInfo*> cached = cache.find(scope, id);
+  if (cached.has_value()) {
+    return *cached;
+  }
+
+  SymbolInfo* result = uncached_name_lookup(scope, id);
+  cache.insert(scope, id, result);
+
+  return result;
+}
+
+SymbolInfo* SemanticAnalyzer::uncached_name_lookup(Scope* scope,
+                                                   const QualifiedId& id) {
   Scope* current_scope = scope;
 
   while (current_scope != nullptr &&
-         !current_scope->has_symbol(id.parts.front())) {
+         !has_symbol(*current_scope, id.parts.front())) {
     current_scope = current_scope->parent;
   }
 
@@ -159,10 +259,13 @@ SymbolInfo* SemanticAnalyzer::name_lookup(Scope* scope, const QualifiedId& id) {
   }
 
   // TODO: handle undefined symbols
-  for (StringId part : id.parts | std::views::take(id.parts.size() - 1)) {
-    NamespaceSymbolInfo& namespace_info =
-        std::get<NamespaceSymbolInfo>(current_scope->symbols.at(part));
+  // first part is already injected by has_symbol above
+  for (size_t i = 1; i < id.parts.size(); ++i) {
+    NamespaceSymbolInfo& namespace_info = std::get<NamespaceSymbolInfo>(
+        current_scope->symbols.at(id.parts[i - 1]));
     current_scope = namespace_info.subscope;
+
+    inject_imported(*current_scope, id.parts[i]);
   }
 
   return &current_scope->symbols.at(id.parts.back());
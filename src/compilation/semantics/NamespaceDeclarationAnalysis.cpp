@@ -4,7 +4,7 @@ namespace Front {
 bool SemanticAnalyzer::traverse_namespace_declaration(NamespaceDecl& node) {
   Scope* subscope;
 
-  if (current_scope_->has_symbol(node.name)) {
+  if (has_symbol(*current_scope_, node.name)) {
     SymbolInfo& info = current_scope_->symbols.at(node.name);
 
     if (!info.is_namespace()) {
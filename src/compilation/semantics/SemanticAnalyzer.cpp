@@ -5,8 +5,13 @@
 #include <algorithm>
 #include <iostream>
 
+#include "ConstantEvaluator.h"
+#include "EffectsAnalyzer.h"
+#include "LastUseAnalyzer.h"
 #include "ast/ASTPrinter.h"
 #include "compilation/ScopePrinter.h"
+#include "profiling/AllocationProfiler.h"
+#include "profiling/Tracer.h"
 
 namespace Front {
 TypesStorage& SemanticAnalyzer::types() { return context_.types_storage; }
@@ -123,18 +128,27 @@ void SemanticAnalyzer::add_to_exported_if_necessary(SymbolInfo& info) {
 void SemanticAnalyzer::analyze() {
   OSO_FIRE();
 
+  Profiling::TraceScope trace("semantic analysis", context_.name);
+  Profiling::AllocationScope allocation_scope(
+      Profiling::AllocationTag::SEMANTICS);
+
   auto name = context_.add_string(fmt::format("module({})", context_.name));
   context_.root_scope = std::make_unique<Scope>(name);
+  context_.root_scope->lookup_cache = &context_.name_lookup_cache;
   current_scope_ = context_.root_scope.get();
 
   for (ModuleContext& exported : context_.dependencies) {
     for (SymbolInfo& exported_symbol : exported.exported_symbols) {
-      inject_symbol(exported, exported_symbol);
+      add_import(exported, exported_symbol);
     }
   }
 
   traverse(*context_.ast_root);
 
+  ConstantEvaluator(context_).evaluate();
+  EffectsAnalyzer(context_).analyze();
+  LastUseAnalyzer(context_).analyze();
+
   // ScopePrinter printer(context_.get_strings_pool(), *context_.root_scope,
   // std::cout);
   // printer.print();
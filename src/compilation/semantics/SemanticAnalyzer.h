@@ -34,12 +34,39 @@ class SemanticAnalyzer
   Scope* current_scope_{nullptr};
   size_t anonymous_namespace_counter_{0};
 
+  // exported symbols of dependencies are injected into scopes only when
+  // they are looked up. Table is keyed by fully qualified names in terms of
+  // this module strings.
+  struct ImportedSymbol {
+    ModuleContext* module;
+    SymbolInfo* symbol;
+
+    // namespace that leads to exported symbol, its other members are hidden
+    bool is_only_path;
+  };
+
+  std::unordered_map<QualifiedId, std::vector<ImportedSymbol>> imports_;
+
   TypesStorage& types();
   SymbolInfo* name_lookup(Scope* scope, const QualifiedId& id);
+  SymbolInfo* uncached_name_lookup(Scope* scope, const QualifiedId& id);
 
   void add_to_exported_if_necessary(SymbolInfo& info);
 
-  void inject_symbol(ModuleContext& module, SymbolInfo& symbol);
+  static std::optional<QualifiedId> get_namespace_path(const Scope& scope);
+
+  void add_import(QualifiedId path, ImportedSymbol imported);
+  void add_import(ModuleContext& module, SymbolInfo& symbol);
+
+  // injects imported symbol with this name if scope is a namespace
+  void inject_imported(Scope& scope, StringId name);
+
+  // must be used instead of Scope::has_symbol, so imported symbols are
+  // taken into account
+  bool has_symbol(Scope& scope, StringId name);
+
+  void inject_symbol(Scope& local_scope, StringId local_name,
+                     const ImportedSymbol& imported);
   Type* inject_type(Type* external_type, const StringPool& external_strings);
 
   [[noreturn]] void scold_user(const ASTNode& node, std::string message);
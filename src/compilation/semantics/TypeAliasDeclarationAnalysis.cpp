@@ -13,9 +13,8 @@ bool SemanticAnalyzer::visit_type_alias_declaration(TypeAliasDecl& node) {
 
   // aliases are strong in TeaLang
   // therefore separate type is created for alias
-  auto [itr, was_emplaced] = current_scope_->symbols.emplace(
+  SymbolInfo& info = current_scope_->add_symbol(
       node.name, TypeAliasSymbolInfo(current_scope_, node, nullptr));
-  SymbolInfo& info = itr->second;
   TypeAliasSymbolInfo& alias_info = std::get<TypeAliasSymbolInfo>(info);
 
   auto qualified_name = info.get_fully_qualified_name();
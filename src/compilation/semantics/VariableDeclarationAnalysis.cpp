@@ -4,7 +4,7 @@
 
 namespace Front {
 bool SemanticAnalyzer::visit_variable_declaration(VariableDecl& node) {
-  if (current_scope_->has_symbol(node.name)) {
+  if (has_symbol(*current_scope_, node.name)) {
     auto name = context_.get_string(node.name);
     scold_user(node, fmt::format("Redefinition of variable {}", name));
   }
@@ -24,6 +24,10 @@ bool SemanticAnalyzer::visit_variable_declaration(VariableDecl& node) {
     }
   }
 
+  if (var_info.is_global()) {
+    context_.global_variables_info.emplace(&node, var_info);
+  }
+
   if (node.initializer != nullptr) {
     if (node.initializer->type != node.type->value) {
       scold_user(node,
@@ -1,26 +1,34 @@
 #pragma once
 
 #include "ast/Nodes.h"
+#include "profiling/AllocationProfiler.h"
 #include "utils/PointersStorage.h"
 
 namespace Front {
 class TypesStorage {
   PointersStorage<Type> storage_;
 
+  template <typename T, typename... Args>
+  T* emplace(Args&&... args) {
+    Profiling::AllocationScope allocation_scope(
+        Profiling::AllocationTag::TYPES);
+    return storage_.get_emplace<T>(std::forward<Args>(args)...);
+  }
+
  public:
   template <typename T, typename... Args>
   T* make_type(Args&&... args) {
-    return storage_.get_emplace<T>(std::forward<Args>(args)...);
+    return emplace<T>(std::forward<Args>(args)...);
   }
 
   PointerType* add_pointer(Type* type) {
-    return storage_.get_emplace<PointerType>(type);
+    return emplace<PointerType>(type);
   }
 
   template <typename T>
     requires std::is_base_of_v<PrimitiveType, T>
   T* add_primitive(size_t width) {
-    return storage_.get_emplace<T>(width);
+    return emplace<T>(width);
   }
 
   PrimitiveType* add_primitive(Type::Kind type_kind, size_t width) {
@@ -39,7 +47,7 @@ class TypesStorage {
   }
 
   AliasType* add_alias(QualifiedId name, Type* type) {
-    Type* alias = storage_.get_emplace<AliasType>(std::move(name), type);
+    Type* alias = emplace<AliasType>(std::move(name), type);
     return static_cast<AliasType*>(alias);
   }
 
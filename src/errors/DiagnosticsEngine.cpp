@@ -0,0 +1,144 @@
+#include "DiagnosticsEngine.h"
+
+#include <fmt/color.h>
+#include <fmt/format.h>
+
+#include <algorithm>
+
+#include "utils/Json.h"
+
+namespace {
+std::string_view to_string(Severity severity) {
+  switch (severity) {
+    case Severity::NOTE:
+      return "note";
+    case Severity::WARNING:
+      return "warning";
+    case Severity::ERROR:
+      return "error";
+  }
+
+  return "unknown";
+}
+}  // namespace
+
+DiagnosticsEngine::DiagnosticsEngine(const SourceManager& source_manager,
+                                     std::ostream& os,
+                                     DiagnosticsFormat format,
+                                     size_t max_errors)
+    : source_manager_(source_manager),
+      os_(os),
+      format_(format),
+      max_errors_(max_errors) {}
+
+DiagnosticsEngine::Position DiagnosticsEngine::get_position(
+    SourceLocation location) {
+  std::string_view file =
+      source_manager_.get_file_view(SourceLocation(location.file_id, 0))
+          .string_view();
+
+  auto& line_starts = line_starts_[location.file_id];
+  if (line_starts.empty()) {
+    line_starts.push_back(0);
+
+    for (size_t i = 0; i < file.size(); ++i) {
+      if (file[i] == '\n') {
+        line_starts.push_back(i + 1);
+      }
+    }
+  }
+
+  size_t line = std::ranges::upper_bound(line_starts, location.pos_id) -
+                line_starts.begin() - 1;
+
+  size_t line_begin = line_starts[line];
+  size_t line_end =
+      line + 1 < line_starts.size() ? line_starts[line + 1] - 1 : file.size();
+
+  return {line, location.pos_id - line_begin,
+          file.substr(line_begin, line_end - line_begin)};
+}
+
+void DiagnosticsEngine::print_text(Severity severity, SourceRange range,
+                                   std::string_view message) {
+  Position begin = get_position(range.begin);
+  Position end = get_position(range.end);
+
+  // multi-line range is emphasized till the end of its first line
+  size_t end_column =
+      begin.line == end.line ? end.column : begin.line_view.size();
+
+  // split line view to emphasize wrong part with red
+  auto line_view = begin.line_view;
+  auto before_error_view = line_view.substr(0, begin.column);
+  auto error_view = line_view.substr(begin.column, end_column - begin.column);
+  auto after_error_view = line_view.substr(end_column);
+
+  os_ << fmt::format("{}:{}:{}: {}:\n",
+                     source_manager_.get_path(range.begin.file_id).string(),
+                     begin.line + 1, begin.column + 1, to_string(severity));
+  os_ << before_error_view
+      << fmt::format(fg(fmt::color::orange), "{}", error_view)
+      << after_error_view << "\n";
+  os_ << std::string(begin.column, ' ') << "`-" << message << std::endl;
+}
+
+void DiagnosticsEngine::print_json(Severity severity, SourceRange range,
+                                   std::string_view message) {
+  Position begin = get_position(range.begin);
+  Position end = get_position(range.end);
+
+  os_ << fmt::format(
+             R"({{"severity":"{}","file":"{}","line":{},"column":{},)"
+             R"("end_line":{},"end_column":{},"message":"{}"}})",
+             to_string(severity),
+             escape_json(
+                 source_manager_.get_path(range.begin.file_id).string()),
+             begin.line + 1, begin.column + 1, end.line + 1, end.column + 1,
+             escape_json(message))
+      << std::endl;
+}
+
+void DiagnosticsEngine::print_limit_note() {
+  auto message = fmt::format(
+      "Too many errors, compilation is stopped (limit is {}).", max_errors_);
+
+  if (format_ == DiagnosticsFormat::JSON) {
+    os_ << fmt::format(R"({{"severity":"note","message":"{}"}})", message)
+        << std::endl;
+  } else {
+    os_ << message << std::endl;
+  }
+}
+
+void DiagnosticsEngine::report(Severity severity, SourceRange range,
+                               std::string_view message) {
+  std::lock_guard lock(mutex_);
+
+  if (has_reached_limit()) {
+    return;
+  }
+
+  // repeats come from the same phase, so only a few of them can get through
+  // after old diagnostics are forgotten
+  if (reported_.size() == kMaxRemembered) {
+    reported_.clear();
+  }
+
+  if (!reported_
+           .emplace(severity, range.begin.file_id, range.begin.pos_id,
+                    range.end.pos_id, message)
+           .second) {
+    return;
+  }
+
+  if (format_ == DiagnosticsFormat::JSON) {
+    print_json(severity, range, message);
+  } else {
+    print_text(severity, range, message);
+  }
+
+  if (severity == Severity::ERROR && ++errors_count_ == max_errors_) {
+    print_limit_note();
+  }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "sources/SourceManager.h"
+#include "utils/Hashers.h"
+
+enum class Severity { NOTE, WARNING, ERROR };
+
+enum class DiagnosticsFormat {
+  // human-readable, with the source line and emphasized range
+  TEXT,
+  // one JSON object per line, for tools
+  JSON
+};
+
+// Prints diagnostics as soon as they are reported. Repeated diagnostics (same
+// severity, range and message) are dropped. Reported diagnostics are
+// remembered for that until there are kMaxRemembered of them, then they are
+// forgotten, so memory stays bounded even without limit of errors.
+// After max_errors errors the rest of diagnostics is dropped, compiler phases
+// check has_reached_limit to stop early. Diagnostics can be reported from
+// several threads.
+class DiagnosticsEngine {
+  const SourceManager& source_manager_;
+  std::ostream& os_;
+  DiagnosticsFormat format_;
+
+  // 0 means no limit
+  size_t max_errors_;
+  std::atomic<size_t> errors_count_{0};
+
+  static constexpr size_t kMaxRemembered = 1024;
+
+  // severity, file id, begin and end of range, message
+  using ReportedKey =
+      std::tuple<Severity, uint32_t, uint32_t, uint32_t, std::string>;
+
+  std::mutex mutex_;
+  // whole diagnostic is kept, so collision of hashes doesn't drop one
+  std::unordered_set<ReportedKey, TupleHasher<Severity, uint32_t, uint32_t,
+                                              uint32_t, std::string>>
+      reported_;
+
+  // file id -> offsets of line beginnings, built on first diagnostic in file
+  std::unordered_map<uint32_t, std::vector<uint32_t>> line_starts_;
+
+  struct Position {
+    size_t line;
+    size_t column;
+    std::string_view line_view;
+  };
+
+  Position get_position(SourceLocation location);
+
+  void print_text(Severity severity, SourceRange range,
+                  std::string_view message);
+  void print_json(Severity severity, SourceRange range,
+                  std::string_view message);
+  void print_limit_note();
+
+ public:
+  DiagnosticsEngine(const SourceManager& source_manager, std::ostream& os,
+                    DiagnosticsFormat format = DiagnosticsFormat::TEXT,
+                    size_t max_errors = 0);
+
+  DiagnosticsEngine(const DiagnosticsEngine&) = delete;
+  DiagnosticsEngine& operator=(const DiagnosticsEngine&) = delete;
+
+  void report(Severity severity, SourceRange range, std::string_view message);
+
+  void error(SourceRange range, std::string_view message) {
+    report(Severity::ERROR, range, message);
+  }
+
+  size_t get_errors_count() const { return errors_count_; }
+
+  bool has_reached_limit() const {
+    return max_errors_ != 0 && errors_count_ >= max_errors_;
+  }
+
+  // how many errors can still be reported, max of size_t when there is no
+  // limit
+  size_t get_remaining_errors() const {
+    if (max_errors_ == 0) {
+      return std::numeric_limits<size_t>::max();
+    }
+
+    return max_errors_ - std::min<size_t>(max_errors_, errors_count_);
+  }
+};
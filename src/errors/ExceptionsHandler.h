@@ -8,19 +8,20 @@
 
 class ExceptionsHandler {
  public:
+  // compile server reports errors of requests into their own streams
   template <std::invocable<> Callable>
-  static int execute(const Callable& callable) {
+  static int execute(const Callable& callable, std::ostream& err = std::cerr) {
     try {
       callable();
     } catch (const Cli::ArgumentsParseException& exception) {
-      std::cerr << "Fatal error when parsing arguments:" << std::endl;
-      std::cerr << exception.what() << std::endl;
-      std::cerr << "Write --help to read help message." << std::endl;
+      err << "Fatal error when parsing arguments:" << std::endl;
+      err << exception.what() << std::endl;
+      err << "Write --help to read help message." << std::endl;
 
       return 1;
     } catch (const std::exception& exception) {
-      std::cerr << "Fatal error:" << std::endl;
-      std::cerr << exception.what() << std::endl;
+      err << "Fatal error:" << std::endl;
+      err << exception.what() << std::endl;
 
       return 1;
     }
@@ -5,6 +5,7 @@
 
 #include "lexis/Charset.h"
 #include "lexis/table/LexicalTableSerializer.h"
+#include "profiling/AllocationProfiler.h"
 
 namespace Lexis {
 Token LexicalAnalyzer::get_token_internal(SourceLocation location) const {
@@ -27,7 +28,7 @@ Token LexicalAnalyzer::get_token_internal(SourceLocation location) const {
       return Token{TokenType::ERROR, SourceRange{cur_loc, cur_loc}};
     }
 
-    auto jump = jumps_[current_state][symbol];
+    auto jump = (*jumps_)[current_state][symbol];
 
     if (std::holds_alternative<NextStateJump>(jump)) {
       current_state = std::get<NextStateJump>(jump).state_id;
@@ -53,7 +54,8 @@ LexicalAnalyzer::LexicalAnalyzer(const std::filesystem::path& path)
           throw std::runtime_error("Failed to open lexis table.");
         }
 
-        return LexicalTableSerializer::deserialize(is);
+        return std::make_shared<const std::vector<JumpTableT>>(
+            LexicalTableSerializer::deserialize(is));
       }()) {}
 
 void LexicalAnalyzer::set_source_view(SourceView view) {
@@ -62,6 +64,8 @@ void LexicalAnalyzer::set_source_view(SourceView view) {
 }
 
 Token LexicalAnalyzer::next_token() {
+  Profiling::AllocationScope allocation_scope(Profiling::AllocationTag::LEXER);
+
   do {
     current_token_ = get_token_internal(location_);
 
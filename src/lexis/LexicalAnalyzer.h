@@ -1,6 +1,7 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -10,7 +11,9 @@
 
 namespace Lexis {
 class LexicalAnalyzer {
-  const std::vector<JumpTableT> jumps_;
+  // table is shared between copies, so preloaded analyzer can be cheaply
+  // copied for each compilation
+  std::shared_ptr<const std::vector<JumpTableT>> jumps_;
   static std::unordered_map<std::string_view, TokenType> keywords;
 
   SourceLocation location_{};
@@ -0,0 +1,119 @@
+#include "AllocationProfiler.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string_view>
+
+namespace Profiling {
+namespace {
+struct AtomicCounters {
+  std::atomic<size_t> allocations{0};
+  std::atomic<size_t> bytes{0};
+};
+
+constexpr size_t kTagsCount = static_cast<size_t>(AllocationTag::count);
+
+// constant initialization, so allocations made before main are counted too
+constinit std::array<AtomicCounters, kTagsCount> counters;
+
+constexpr std::array<std::string_view, kTagsCount> kTagNames = {
+    "other", "lexer",  "parser",    "AST",          "strings",
+    "types", "scopes", "semantics", "IR generation"};
+
+[[maybe_unused]] void count_allocation(size_t size) {
+  auto& tag_counters =
+      counters[static_cast<size_t>(AllocationProfiler::current_tag)];
+
+  tag_counters.allocations.fetch_add(1, std::memory_order_relaxed);
+  tag_counters.bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+double to_mebibytes(size_t bytes) {
+  return static_cast<double>(bytes) / (1024 * 1024);
+}
+}  // namespace
+
+thread_local AllocationTag AllocationProfiler::current_tag =
+    AllocationTag::OTHER;
+
+AllocationProfiler::Stats AllocationProfiler::get_stats() {
+  Stats result;
+
+  for (size_t i = 0; i < result.size(); ++i) {
+    result[i].allocations =
+        counters[i].allocations.load(std::memory_order_relaxed);
+    result[i].bytes = counters[i].bytes.load(std::memory_order_relaxed);
+  }
+
+  return result;
+}
+
+void AllocationProfiler::print(std::ostream& os, const Stats& since) {
+  Stats stats = get_stats();
+  Counters total;
+
+  os << "===------------------- Allocations report -------------------===\n";
+  os << fmt::format("{:>12}  {:>12}  {}\n", "Allocations", "MiB",
+                    "Subsystem");
+
+  for (size_t i = 0; i < stats.size(); ++i) {
+    size_t allocations = stats[i].allocations - since[i].allocations;
+    size_t bytes = stats[i].bytes - since[i].bytes;
+
+    total.allocations += allocations;
+    total.bytes += bytes;
+
+    os << fmt::format("{:>12}  {:>12.2f}  {}\n", allocations,
+                      to_mebibytes(bytes), kTagNames[i]);
+  }
+
+  os << fmt::format("{:>12}  {:>12.2f}  {}\n", total.allocations,
+                    to_mebibytes(total.bytes), "total");
+}
+}  // namespace Profiling
+
+#ifdef TEALANG_ALLOCATION_PROFILING
+// Replaced global allocation functions. Other forms of operator new (arrays,
+// nothrow) call these by default, deallocation isn't tracked.
+
+void* operator new(size_t size) {
+  Profiling::count_allocation(size);
+
+  // malloc(0) may return nullptr, but operator new must return a pointer
+  if (void* result = std::malloc(size == 0 ? 1 : size)) {
+    return result;
+  }
+
+  throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+  Profiling::count_allocation(size);
+
+  auto align = static_cast<size_t>(alignment);
+  // aligned_alloc requires size to be a multiple of alignment
+  size_t aligned_size = (std::max<size_t>(size, 1) + align - 1) / align * align;
+
+  if (void* result = std::aligned_alloc(align, aligned_size)) {
+    return result;
+  }
+
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, size_t) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+#endif
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+
+namespace Profiling {
+#ifdef TEALANG_ALLOCATION_PROFILING
+inline constexpr bool kIsAllocationProfilingEnabled = true;
+#else
+inline constexpr bool kIsAllocationProfilingEnabled = false;
+#endif
+
+// subsystem which allocations are attributed to
+enum class AllocationTag : uint8_t {
+  OTHER,
+  LEXER,
+  PARSER,
+  AST,
+  STRINGS,
+  TYPES,
+  SCOPES,
+  SEMANTICS,
+  IR,
+
+  count
+};
+
+// Counts allocations made through global operator new in each subsystem.
+// Counting is compiled in only with TEALANG_ALLOCATION_PROFILING cmake option,
+// then operator new is replaced and attributes every allocation to the tag of
+// the innermost AllocationScope on the current thread. Without the option
+// scopes are empty objects and all counters are zero.
+// Counters are cumulative (allocation traffic, not live memory).
+class AllocationProfiler {
+ public:
+  struct Counters {
+    size_t allocations{0};
+    size_t bytes{0};
+  };
+
+  using Stats =
+      std::array<Counters, static_cast<size_t>(AllocationTag::count)>;
+
+  static thread_local AllocationTag current_tag;
+
+  static Stats get_stats();
+
+  // prints allocations made since `since` snapshot
+  static void print(std::ostream& os, const Stats& since);
+};
+
+// attributes allocations of the current thread to the tag until scope ends
+class AllocationScope {
+  AllocationTag previous_{AllocationTag::OTHER};
+
+ public:
+  explicit AllocationScope(AllocationTag tag) {
+    if constexpr (kIsAllocationProfilingEnabled) {
+      previous_ = std::exchange(AllocationProfiler::current_tag, tag);
+    }
+  }
+
+  AllocationScope(const AllocationScope&) = delete;
+  AllocationScope& operator=(const AllocationScope&) = delete;
+
+  ~AllocationScope() {
+    if constexpr (kIsAllocationProfilingEnabled) {
+      AllocationProfiler::current_tag = previous_;
+    }
+  }
+};
+}  // namespace Profiling
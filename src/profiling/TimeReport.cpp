@@ -0,0 +1,162 @@
+#include "TimeReport.h"
+
+#include <fmt/format.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <ctime>
+#include <ranges>
+
+namespace Profiling {
+namespace {
+// nesting level of running timers on the current thread
+thread_local size_t current_depth = 0;
+
+double to_seconds(std::chrono::nanoseconds duration) {
+  return std::chrono::duration<double>(duration).count();
+}
+
+double to_mebibytes(size_t bytes) {
+  return static_cast<double>(bytes) / (1 << 20);
+}
+}  // namespace
+
+TimeReport::Counters& TimeReport::Counters::operator+=(const Counters& other) {
+  wall += other.wall;
+  cpu += other.cpu;
+  peak_rss_growth += other.peak_rss_growth;
+  count += other.count;
+
+  return *this;
+}
+
+TimeReport::Timer::Timer(TimeReport* report, std::string_view name,
+                         std::string_view module, const Timer* parent)
+    : report_(report), name_(name), module_(module) {
+  if (report_ == nullptr) {
+    return;
+  }
+
+  previous_depth_ = current_depth;
+  depth_ = parent != nullptr ? parent->depth_ + 1 : current_depth;
+  current_depth = depth_ + 1;
+
+  peak_rss_start_ = get_peak_rss();
+  cpu_start_ = get_thread_cpu_time();
+  wall_start_ = std::chrono::steady_clock::now();
+}
+
+TimeReport::Timer::~Timer() {
+  if (report_ == nullptr) {
+    return;
+  }
+
+  Counters counters;
+  counters.wall = std::chrono::steady_clock::now() - wall_start_;
+  counters.cpu = get_thread_cpu_time() - cpu_start_;
+  counters.peak_rss_growth = get_peak_rss() - peak_rss_start_;
+  counters.count = 1;
+
+  current_depth = previous_depth_;
+  report_->add(*this, counters);
+}
+
+std::chrono::nanoseconds TimeReport::get_thread_cpu_time() {
+  timespec time;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+
+  return std::chrono::seconds(time.tv_sec) +
+         std::chrono::nanoseconds(time.tv_nsec);
+}
+
+size_t TimeReport::get_peak_rss() {
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+
+#ifdef __APPLE__
+  // macOS reports bytes, while linux reports kilobytes
+  return usage.ru_maxrss;
+#else
+  return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+}
+
+void TimeReport::add(const Timer& timer, const Counters& counters) {
+  std::lock_guard guard(mutex_);
+
+  // there are only a few phases, so linear search is fine
+  auto itr = std::ranges::find_if(entries_, [&timer](const Entry& entry) {
+    return entry.name == timer.name_ && entry.depth == timer.depth_;
+  });
+
+  if (itr == entries_.end()) {
+    itr = entries_.insert(itr, Entry{std::string(timer.name_), timer.depth_,
+                                     timer.wall_start_, {}, {}});
+  }
+
+  itr->first_start = std::min(itr->first_start, timer.wall_start_);
+  itr->total += counters;
+
+  if (!timer.module_.empty()) {
+    auto [module_itr, _] = itr->modules.try_emplace(std::string(timer.module_));
+    module_itr->second += counters;
+  }
+}
+
+void TimeReport::add_statistic(std::string_view name, std::string_view module,
+                               size_t value) {
+  std::lock_guard guard(mutex_);
+
+  statistics_[std::string(name)][std::string(module)] += value;
+}
+
+void TimeReport::print(std::ostream& os) const {
+  std::lock_guard guard(mutex_);
+
+  auto print_row = [&os](const Counters& counters, std::string_view name,
+                         size_t indent) {
+    os << fmt::format("{:>10.4f}  {:>10.4f}  {:>10.2f}  {:>6}  {:{}}{}\n",
+                      to_seconds(counters.wall), to_seconds(counters.cpu),
+                      to_mebibytes(counters.peak_rss_growth), counters.count,
+                      "", 2 * indent, name);
+  };
+
+  os << "===---------------------- Time report ----------------------===\n";
+  os << fmt::format("{:>10}  {:>10}  {:>10}  {:>6}  {}\n", "Wall (s)",
+                    "CPU (s)", "+RSS (MiB)", "Count", "Phase");
+
+  std::vector<const Entry*> entries;
+  for (const Entry& entry : entries_) {
+    entries.push_back(&entry);
+  }
+
+  std::ranges::sort(entries, {}, &Entry::first_start);
+
+  for (const Entry* entry : entries) {
+    print_row(entry->total, entry->name, entry->depth);
+
+    for (const auto& [module, counters] : entry->modules) {
+      print_row(counters, fmt::format("[{}]", module), entry->depth + 1);
+    }
+  }
+
+  os << fmt::format("Peak RSS: {:.2f} MiB\n", to_mebibytes(get_peak_rss()));
+
+  if (statistics_.empty()) {
+    return;
+  }
+
+  os << "===---------------------- Statistics -----------------------===\n";
+  for (const auto& [name, modules] : statistics_) {
+    size_t total = 0;
+    for (size_t value : modules | std::views::values) {
+      total += value;
+    }
+
+    os << fmt::format("{:>10}  {}\n", total, name);
+    for (const auto& [module, value] : modules) {
+      os << fmt::format("{:>10}    [{}]\n", value, module);
+    }
+  }
+}
+}  // namespace Profiling
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Profiling {
+// Collects wall time, CPU time and peak RSS growth of compiler phases.
+// Phases started while another phase is running on the same thread are
+// nested into it. Measurements of one phase are additionally split by module.
+// Timers are cheap: two clock reads and one getrusage call on each side, and
+// nothing at all when report is disabled (nullptr is passed).
+// Subsystems can also add named statistics, like hits of caches, they are
+// summed and split by module too.
+class TimeReport {
+ public:
+  struct Counters {
+    std::chrono::nanoseconds wall{0};
+
+    // CPU time of the thread that ran the phase
+    std::chrono::nanoseconds cpu{0};
+
+    // how much peak RSS of the process has grown during the phase
+    size_t peak_rss_growth{0};
+
+    size_t count{0};
+
+    Counters& operator+=(const Counters& other);
+  };
+
+  class Timer {
+    TimeReport* report_;
+    std::string_view name_;
+    std::string_view module_;
+
+    size_t depth_{0};
+    size_t previous_depth_{0};
+    std::chrono::steady_clock::time_point wall_start_;
+    std::chrono::nanoseconds cpu_start_{0};
+    size_t peak_rss_start_{0};
+
+    friend class TimeReport;
+
+   public:
+    // empty module means that phase is not related to a particular module.
+    // parent is used to nest phases that run on other threads
+    Timer(TimeReport* report, std::string_view name,
+          std::string_view module = {}, const Timer* parent = nullptr);
+
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
+    ~Timer();
+  };
+
+ private:
+  struct Entry {
+    std::string name;
+    size_t depth;
+
+    // entries are printed in order of their first start, so nested phases
+    // follow their parents
+    std::chrono::steady_clock::time_point first_start;
+
+    Counters total;
+    std::map<std::string, Counters, std::less<>> modules;
+  };
+
+  mutable std::mutex mutex_;
+  std::vector<Entry> entries_;
+
+  // name -> module -> value, printed in order of names
+  std::map<std::string, std::map<std::string, size_t, std::less<>>,
+           std::less<>>
+      statistics_;
+
+  void add(const Timer& timer, const Counters& counters);
+
+ public:
+  void add_statistic(std::string_view name, std::string_view module,
+                     size_t value);
+
+  static std::chrono::nanoseconds get_thread_cpu_time();
+
+  // peak resident set size of the process in bytes
+  static size_t get_peak_rss();
+
+  void print(std::ostream& os) const;
+};
+}  // namespace Profiling
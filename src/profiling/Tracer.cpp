@@ -0,0 +1,72 @@
+#include "Tracer.h"
+
+#include <fmt/format.h>
+
+#include <atomic>
+
+#include "utils/Json.h"
+
+namespace Profiling {
+namespace {
+// small sequential ids are easier to read in the viewer than system ids
+size_t get_thread_id() {
+  static std::atomic<size_t> threads_count{0};
+  thread_local size_t id = threads_count++;
+
+  return id;
+}
+}  // namespace
+
+thread_local Tracer* Tracer::active_{nullptr};
+
+Tracer::Tracer() : start_(std::chrono::steady_clock::now()) {}
+
+int64_t Tracer::get_timestamp(
+    std::chrono::steady_clock::time_point time) const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(time - start_)
+      .count();
+}
+
+void Tracer::write(std::ostream& os) {
+  std::lock_guard guard(mutex_);
+
+  os << "{\"traceEvents\":[";
+
+  for (size_t i = 0; i < events_.size(); ++i) {
+    const Event& event = events_[i];
+
+    os << (i == 0 ? "\n" : ",\n");
+    os << fmt::format(
+        R"({{"name":"{}","cat":"tlang","ph":"X","ts":{},"dur":{},"pid":1,)"
+        R"("tid":{})",
+        escape_json(event.name), event.begin, event.duration, event.thread_id);
+
+    if (!event.module.empty()) {
+      os << fmt::format(R"(,"args":{{"module":"{}"}})",
+                        escape_json(event.module));
+    }
+
+    os << "}";
+  }
+
+  os << "\n]}\n";
+}
+
+TraceScope::~TraceScope() {
+  if (tracer_ == nullptr) {
+    return;
+  }
+
+  auto end = std::chrono::steady_clock::now();
+
+  Tracer::Event event{name_,
+                      std::string(module_),
+                      get_thread_id(),
+                      tracer_->get_timestamp(begin_),
+                      tracer_->get_timestamp(end) -
+                          tracer_->get_timestamp(begin_)};
+
+  std::lock_guard guard(tracer_->mutex_);
+  tracer_->events_.push_back(std::move(event));
+}
+}  // namespace Profiling
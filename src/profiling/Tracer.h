@@ -0,0 +1,87 @@
+#pragma once
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Profiling {
+// Collects complete ("X") events of Chrome trace-event format, they can be
+// viewed in chrome://tracing or ui.perfetto.dev.
+// Probes (TraceScope) write into the tracer active on their thread, so
+// concurrent compilations in one process (compile server, batch) trace only
+// themselves. Worker threads of a compilation activate its tracer explicitly.
+// When there is no active tracer probes only read a thread local pointer.
+class Tracer {
+  struct Event {
+    std::string_view name;
+    std::string module;
+    size_t thread_id;
+
+    // in microseconds since tracer creation
+    int64_t begin;
+    int64_t duration;
+  };
+
+  static thread_local Tracer* active_;
+
+  std::chrono::steady_clock::time_point start_;
+
+  std::mutex mutex_;
+  std::vector<Event> events_;
+
+  int64_t get_timestamp(std::chrono::steady_clock::time_point time) const;
+
+  friend class TraceScope;
+  friend class ActiveTracerScope;
+
+ public:
+  Tracer();
+
+  Tracer(const Tracer&) = delete;
+  Tracer& operator=(const Tracer&) = delete;
+
+  static Tracer* get_active() { return active_; }
+
+  void write(std::ostream& os);
+};
+
+// Makes tracer (or none) active on current thread until the end of the scope.
+// Tracer must outlive the scope.
+class ActiveTracerScope {
+  Tracer* previous_;
+
+ public:
+  explicit ActiveTracerScope(Tracer* tracer)
+      : previous_(std::exchange(Tracer::active_, tracer)) {}
+
+  ActiveTracerScope(const ActiveTracerScope&) = delete;
+  ActiveTracerScope& operator=(const ActiveTracerScope&) = delete;
+
+  ~ActiveTracerScope() { Tracer::active_ = previous_; }
+};
+
+class TraceScope {
+  Tracer* tracer_;
+  std::string_view name_;
+  std::string_view module_;
+  std::chrono::steady_clock::time_point begin_;
+
+ public:
+  // name must be a string literal, module is copied at the end of the scope
+  explicit TraceScope(std::string_view name, std::string_view module = {})
+      : tracer_(Tracer::get_active()), name_(name), module_(module) {
+    if (tracer_ != nullptr) {
+      begin_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+  ~TraceScope();
+};
+}  // namespace Profiling
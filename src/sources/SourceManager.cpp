@@ -1,7 +1,6 @@
 #include "SourceManager.h"
 
 #include <fcntl.h>
-#include <fmt/color.h>
 #include <fmt/format.h>
 #include <sys/errno.h>
 #include <sys/mman.h>
@@ -111,39 +110,6 @@ SourceManager::LineInfo SourceManager::get_line_info(
   return {view, line_index, offset};
 }
 
-void SourceManager::add_annotation(SourceRange range, std::string_view text) {
-  annotations_.emplace_back(range, text);
-}
-
-void SourceManager::print_annotations(std::ostream& os) {
-  for (const SourceAnnotation& annotation : annotations_) {
-    auto [file_id, position] = annotation.range.begin;
-    auto [begin, size, path] = loaded_[file_id];
-    auto [line_view, start_index, start_offset] =
-        get_line_info(annotation.range.begin);
-
-    auto [_, end_index, end_offset] = get_line_info(annotation.range.end);
-
-    if (start_index != end_index) {
-      // TODO: implement multi-line annotations
-      throw std::runtime_error("Annotations must be on one line.");
-    }
-
-    // split line view to emphasize wrong part with red
-    auto before_error_view = line_view.substr(0, start_offset);
-    auto error_view = line_view.substr(start_offset, end_offset - start_offset);
-    std::string emphasized_error =
-        fmt::format(fg(fmt::color::orange), "{}", error_view);
-    auto after_error_view = line_view.substr(end_offset);
-
-    os << fmt::format("{}:{}:{}:\n", path.c_str(), start_index + 1,
-                      start_offset + 1);
-    os << before_error_view << emphasized_error << after_error_view << "\n";
-    os << std::string(start_offset, ' ') << "`-" << annotation.value
-       << std::endl;
-  }
-}
-
 SourceManager::~SourceManager() {
   for (auto& [begin, size, path] : loaded_) {
     if (path.empty()) {
@@ -5,14 +5,6 @@
 
 #include "SourceLocation.h"
 
-struct SourceAnnotation {
-  SourceRange range;
-  std::string value;
-
-  SourceAnnotation(SourceRange range, std::string_view value)
-      : range(range), value(value) {}
-};
-
 struct LoadedFileInfo {
   char* begin;
   size_t size;
@@ -77,7 +69,6 @@ class SourceView {
 
 class SourceManager {
   std::vector<LoadedFileInfo> loaded_;
-  std::vector<SourceAnnotation> annotations_;
 
  public:
   SourceManager() = default;
@@ -101,10 +92,12 @@ class SourceManager {
   };
   LineInfo get_line_info(SourceLocation location) const;
 
-  void add_annotation(SourceRange range, std::string_view text);
-  void print_annotations(std::ostream& os);
-
   size_t loaded_count() const { return loaded_.size(); }
 
+  // empty for texts loaded with load_text
+  const std::filesystem::path& get_path(uint32_t file_id) const {
+    return loaded_.at(file_id).path;
+  }
+
   ~SourceManager();
 };
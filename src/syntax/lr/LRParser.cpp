@@ -5,6 +5,9 @@
 
 #include <span>
 
+#include "profiling/AllocationProfiler.h"
+#include "profiling/Tracer.h"
+
 using enum Front::BinaryOperator::OpType::InternalEnum;
 using namespace Front;
 #include "syntax/BuildersRegistry.h"
@@ -101,7 +104,11 @@ class RecoveryTree {
 };
 
 void LRParser::parse(Lexis::LexicalAnalyzer& lexical_analyzer,
-                     ModuleContext& context, SourceView source) const {
+                     ModuleContext& context, SourceView source,
+                     size_t max_errors) const {
+  Profiling::TraceScope trace("parse", context.name);
+  Profiling::AllocationScope allocation_scope(Profiling::AllocationTag::PARSER);
+
   ASTBuildContext build_context(context.get_strings_pool(), source);
   std::vector<size_t> states_stack;
 
@@ -146,7 +153,7 @@ void LRParser::parse(Lexis::LexicalAnalyzer& lexical_analyzer,
 
       // try to recover using RecoveryTree
       // if it is broken then there is nothing we can do
-      if (recovery_tree.is_broken()) {
+      if (recovery_tree.is_broken() || errors.size() >= max_errors) {
         break;
       }
 
@@ -192,9 +199,12 @@ void LRParser::parse(Lexis::LexicalAnalyzer& lexical_analyzer,
                 : SourceRange::merge(nodes_span.front()->source_range,
                                      nodes_span.back()->source_range);
 
-        std::unique_ptr<ASTNode> new_node =
-            (build_context.*builders[reduce.production_index])(source_range,
-                                                               nodes_span);
+        std::unique_ptr<ASTNode> new_node;
+        {
+          Profiling::AllocationScope ast_scope(Profiling::AllocationTag::AST);
+          new_node = (build_context.*builders[reduce.production_index])(
+              source_range, nodes_span);
+        }
 
         nodes_stack.resize(nodes_stack.size() - reduce.remove_count);
         nodes_stack.push_back(std::move(new_node));
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <fstream>
+#include <limits>
 #include <memory>
 
 #include "LRTableBuilder.h"
@@ -47,7 +48,10 @@ class LRParser {
           return LRTableSerializer::deserialize(is);
         }()) {}
 
+  // parser recovers after syntax errors to report as many of them as
+  // possible, but stops after max_errors errors
   void parse(Lexis::LexicalAnalyzer& lexical_analyzer,
-             Front::ModuleContext& context, SourceView source) const;
+             Front::ModuleContext& context, SourceView source,
+             size_t max_errors = std::numeric_limits<size_t>::max()) const;
 };
 }  // namespace Syntax
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <fmt/format.h>
+
+#include <string>
+#include <string_view>
+
+// escapes string to be put between quotes in JSON
+inline std::string escape_json(std::string_view string) {
+  std::string result;
+  result.reserve(string.size());
+
+  for (char symbol : string) {
+    if (symbol == '"' || symbol == '\\') {
+      result += '\\';
+      result += symbol;
+    } else if (static_cast<unsigned char>(symbol) < 0x20) {
+      result += fmt::format("\\u{:04x}", static_cast<int>(symbol));
+    } else {
+      result += symbol;
+    }
+  }
+
+  return result;
+}
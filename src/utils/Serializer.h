@@ -12,4 +12,33 @@ protected:
     is.read(reinterpret_cast<char*>(&result), sizeof(size_t));
     return result;
   }
+
+  // LEB128-like variable length encoding: small values take one byte
+  static void write_varint(size_t value, std::ostream& os) {
+    while (value >= 0x80) {
+      os.put(static_cast<char>((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+
+    os.put(static_cast<char>(value));
+  }
+
+  static size_t read_varint(std::istream& is) {
+    size_t result = 0;
+
+    for (size_t shift = 0; shift < 8 * sizeof(size_t); shift += 7) {
+      int byte = is.get();
+      if (byte == std::istream::traits_type::eof()) {
+        break;
+      }
+
+      result |= static_cast<size_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return result;
+      }
+    }
+
+    is.setstate(std::ios::failbit);
+    return 0;
+  }
 };
\ No newline at end of file
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+// Vector that stores up to InlineCapacity elements inside the object itself
+// and falls back to heap allocation only when it grows bigger. It is used for
+// small sequences that are created very often (like parts of QualifiedId).
+// For simplicity only trivially destructible types are supported: destructors
+// of elements are never called.
+template <typename T, size_t InlineCapacity>
+  requires std::is_trivially_destructible_v<T> &&
+           std::is_copy_constructible_v<T> && (InlineCapacity > 0)
+class SmallVector {
+  T* data_;
+  uint32_t size_{0};
+  uint32_t capacity_{InlineCapacity};
+
+  alignas(T) std::byte inline_storage_[InlineCapacity * sizeof(T)];
+
+  T* inline_data() { return reinterpret_cast<T*>(inline_storage_); }
+  const T* inline_data() const {
+    return reinterpret_cast<const T*>(inline_storage_);
+  }
+
+  bool is_inline() const { return data_ == inline_data(); }
+
+  void release() {
+    if (!is_inline()) {
+      std::allocator<T>().deallocate(data_, capacity_);
+    }
+
+    data_ = inline_data();
+    capacity_ = InlineCapacity;
+  }
+
+  void steal(SmallVector& other) {
+    if (other.is_inline()) {
+      std::uninitialized_copy_n(other.data_, other.size_, data_);
+    } else {
+      data_ = other.data_;
+      capacity_ = other.capacity_;
+
+      other.data_ = other.inline_data();
+      other.capacity_ = InlineCapacity;
+    }
+
+    size_ = other.size_;
+    other.size_ = 0;
+  }
+
+ public:
+  using value_type = T;
+  using size_type = size_t;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  SmallVector() : data_(inline_data()) {}
+
+  SmallVector(std::initializer_list<T> values) : SmallVector() {
+    append(values.begin(), values.end());
+  }
+
+  template <std::input_iterator It>
+  SmallVector(It first, It last) : SmallVector() {
+    append(first, last);
+  }
+
+  SmallVector(const SmallVector& other) : SmallVector() {
+    append(other.begin(), other.end());
+  }
+
+  SmallVector(SmallVector&& other) noexcept : SmallVector() { steal(other); }
+
+  SmallVector& operator=(const SmallVector& other) {
+    if (this != &other) {
+      size_ = 0;
+      append(other.begin(), other.end());
+    }
+
+    return *this;
+  }
+
+  SmallVector& operator=(SmallVector&& other) noexcept {
+    if (this != &other) {
+      release();
+      steal(other);
+    }
+
+    return *this;
+  }
+
+  ~SmallVector() { release(); }
+
+  void reserve(size_t capacity) {
+    if (capacity <= capacity_) {
+      return;
+    }
+
+    T* new_data = std::allocator<T>().allocate(capacity);
+    std::uninitialized_copy_n(data_, size_, new_data);
+
+    size_t size = size_;
+    release();
+
+    data_ = new_data;
+    size_ = size;
+    capacity_ = capacity;
+  }
+
+  void push_back(const T& value) {
+    if (size_ == capacity_) {
+      // value can be a reference to element of this vector
+      T copy(value);
+      reserve(2 * capacity_);
+      std::construct_at(data_ + size_, std::move(copy));
+    } else {
+      std::construct_at(data_ + size_, value);
+    }
+
+    ++size_;
+  }
+
+  template <std::input_iterator It>
+  void append(It first, It last) {
+    for (; first != last; ++first) {
+      push_back(*first);
+    }
+  }
+
+  void pop_back() { --size_; }
+
+  void clear() { size_ = 0; }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  T& operator[](size_t index) { return data_[index]; }
+  const T& operator[](size_t index) const { return data_[index]; }
+
+  T& front() { return data_[0]; }
+  const T& front() const { return data_[0]; }
+
+  T& back() { return data_[size_ - 1]; }
+  const T& back() const { return data_[size_ - 1]; }
+
+  T* data() { return data_; }
+  const T* data() const { return data_; }
+
+  iterator begin() { return data_; }
+  iterator end() { return data_ + size_; }
+  const_iterator begin() const { return data_; }
+  const_iterator end() const { return data_ + size_; }
+
+  bool operator==(const SmallVector& other) const {
+    return std::ranges::equal(*this, other);
+  }
+};
@@ -4,6 +4,7 @@
 #include <string>
 
 #include "StringId.h"
+#include "profiling/AllocationProfiler.h"
 
 class StringPool {
   // I use std::less<void> to compare std::string with std::string_view without
@@ -12,6 +13,9 @@ class StringPool {
 
 public:
   StringId add_string(std::string_view string) {
+    Profiling::AllocationScope allocation_scope(
+        Profiling::AllocationTag::STRINGS);
+
     auto [itr, _] = strings_table_.emplace(string);
     return StringId(itr);
   }
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size pool of worker threads with one shared tasks queue.
+// Tasks are allowed to submit new tasks, wait() returns only when the queue
+// is empty and no task is running.
+class ThreadPool {
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> tasks_;
+
+  std::mutex mutex_;
+  std::condition_variable has_tasks_;
+  std::condition_variable is_idle_;
+
+  size_t running_{0};
+  bool is_stopped_{false};
+
+  void work() {
+    while (true) {
+      std::function<void()> task;
+
+      {
+        std::unique_lock lock(mutex_);
+        has_tasks_.wait(lock,
+                        [this] { return is_stopped_ || !tasks_.empty(); });
+
+        if (tasks_.empty()) {
+          return;
+        }
+
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+        ++running_;
+      }
+
+      // tasks are expected to handle their exceptions themselves
+      task();
+
+      {
+        std::lock_guard lock(mutex_);
+        --running_;
+
+        if (running_ == 0 && tasks_.empty()) {
+          is_idle_.notify_all();
+        }
+      }
+    }
+  }
+
+ public:
+  explicit ThreadPool(size_t threads_count) {
+    workers_.reserve(threads_count);
+
+    for (size_t i = 0; i < threads_count; ++i) {
+      workers_.emplace_back([this] { work(); });
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  void submit(std::function<void()> task) {
+    {
+      std::lock_guard lock(mutex_);
+      tasks_.push_back(std::move(task));
+    }
+
+    has_tasks_.notify_one();
+  }
+
+  void wait() {
+    std::unique_lock lock(mutex_);
+    is_idle_.wait(lock, [this] { return running_ == 0 && tasks_.empty(); });
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard lock(mutex_);
+      is_stopped_ = true;
+    }
+
+    has_tasks_.notify_all();
+
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+};
@@ -0,0 +1,73 @@
+#!/usr/bin/env python
+
+# End-to-end latency of compilation through compile server compared with cold
+# compiler runs. Both variants compile the same sources with module cache, so
+# the difference shows the cost of process startup, tables loading and cache
+# reading from disk.
+#
+# usage: compile_server.py <tlang> <runs> <compiler arguments...>
+# example: compile_server.py build/cli 50 main:main.tea module:module.tea
+
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+
+def measure(command, runs):
+    result = []
+
+    for _ in range(runs):
+        begin = time.perf_counter()
+        subprocess.run(command, check=True, stdout=subprocess.DEVNULL)
+        result.append((time.perf_counter() - begin) * 1000)
+
+    return result
+
+
+def report(name, latencies):
+    latencies = sorted(latencies)
+    p90 = latencies[int(len(latencies) * 0.9) - 1]
+
+    print(f"{name:>8}: median {statistics.median(latencies):8.2f} ms, "
+          f"p90 {p90:8.2f} ms, min {latencies[0]:8.2f} ms")
+
+
+def main():
+    [_, tea_compiler, runs, *arguments] = sys.argv
+    runs = int(runs)
+
+    with tempfile.TemporaryDirectory() as tempdir:
+        socket = os.path.join(tempdir, "server.sock")
+        output = ["-o", os.path.join(tempdir, "out.ll")]
+
+        cold_arguments = [*arguments, *output,
+                          "--module-cache", os.path.join(tempdir, "cold")]
+        client_arguments = [*arguments, *output,
+                            "--module-cache", os.path.join(tempdir, "warm")]
+
+        server = subprocess.Popen([tea_compiler, "--server", socket],
+                                  stderr=subprocess.DEVNULL)
+
+        try:
+            while not os.path.exists(socket):
+                time.sleep(0.01)
+
+            client = [tea_compiler, "--connect", socket, *client_arguments]
+            cold = [tea_compiler, *cold_arguments]
+
+            # first runs fill caches
+            measure(cold, 1)
+            measure(client, 1)
+
+            report("cold", measure(cold, runs))
+            report("client", measure(client, runs))
+        finally:
+            subprocess.run([tea_compiler, "--connect", socket, "--shutdown"])
+            server.wait()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,65 @@
+#!/usr/bin/env python
+
+# Size of object files of programs from tests/lit/execution and time of
+# linking them into executables, built by two builds of tlang at -O0, for
+# example before and after dead functions elimination.
+#
+# usage: dead_functions.py <old tlang> <new tlang> <clang> <library> <runs>
+# example: dead_functions.py old/cli build/cli clang \
+#     build/tests/lit/execution/liblibrary.a 20
+
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+PROGRAMS = os.path.join(os.path.dirname(__file__), "..", "lit", "execution",
+                        "programs")
+
+
+def measure(command, runs):
+    result = []
+
+    for _ in range(runs):
+        begin = time.perf_counter()
+        subprocess.run(command, check=True, stdout=subprocess.DEVNULL)
+        result.append((time.perf_counter() - begin) * 1000)
+
+    return statistics.median(result)
+
+
+def build(tea_compiler, clang, library, program, runs, tempdir):
+    obj = os.path.join(tempdir, "out.o")
+    exe = os.path.join(tempdir, "exe")
+
+    subprocess.run([tea_compiler, program, "--emit", "obj", "-O0", "-o", obj],
+                   check=True)
+    link_time = measure([clang, obj, library, "-o", exe], runs)
+
+    return os.path.getsize(obj), os.path.getsize(exe), link_time
+
+
+def main():
+    [_, old_compiler, new_compiler, clang, library, runs] = sys.argv
+    runs = int(runs)
+
+    print(f"{'program':>28} {'build':>5} {'obj bytes':>10} {'exe bytes':>10} "
+          f"{'link ms':>8}")
+
+    for name in sorted(os.listdir(PROGRAMS)):
+        program = os.path.join(PROGRAMS, name)
+
+        for build_name, tea_compiler in [("old", old_compiler),
+                                         ("new", new_compiler)]:
+            with tempfile.TemporaryDirectory() as tempdir:
+                obj_size, exe_size, link_time = build(
+                    tea_compiler, clang, library, program, runs, tempdir)
+
+            print(f"{name:>28} {build_name:>5} {obj_size:>10} {exe_size:>10} "
+                  f"{link_time:8.2f}")
+
+
+if __name__ == "__main__":
+    main()
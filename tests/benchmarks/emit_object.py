@@ -0,0 +1,65 @@
+#!/usr/bin/env python
+
+# End-to-end time of building an executable from tea sources: textual IR
+# piped through llc compared with object file emitted by tlang in process.
+# Both variants use the same optimization level (-O0..-O3, llc has no -Os)
+# for tlang and llc.
+#
+# usage: emit_object.py <tlang> <llc> <clang> <library> <runs> <level> \
+#     <compiler arguments...>
+# example: emit_object.py build/cli llc clang \
+#     build/tests/lit/execution/liblibrary.a 20 -O2 main:main.tea
+
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+
+def measure(commands, runs):
+    result = []
+
+    for _ in range(runs):
+        begin = time.perf_counter()
+        for command in commands:
+            subprocess.run(command, check=True, stdout=subprocess.DEVNULL)
+        result.append((time.perf_counter() - begin) * 1000)
+
+    return result
+
+
+def report(name, latencies):
+    latencies = sorted(latencies)
+
+    print(f"{name:>8}: median {statistics.median(latencies):8.2f} ms, "
+          f"min {latencies[0]:8.2f} ms")
+
+
+def main():
+    [_, tea_compiler, llc, clang, library, runs, level, *arguments] = sys.argv
+    runs = int(runs)
+
+    with tempfile.TemporaryDirectory() as tempdir:
+        ir = os.path.join(tempdir, "out.ll")
+        asm = os.path.join(tempdir, "out.s")
+        obj = os.path.join(tempdir, "out.o")
+        exe = os.path.join(tempdir, "exe")
+
+        through_llc = [
+            [tea_compiler, *arguments, level, "--emit", "ir", "-o", ir],
+            [llc, level, ir, "-o", asm],
+            [clang, asm, library, "-o", exe],
+        ]
+        in_process = [
+            [tea_compiler, *arguments, level, "--emit", "obj", "-o", obj],
+            [clang, obj, library, "-o", exe],
+        ]
+
+        report("llc", measure(through_llc, runs))
+        report("obj", measure(in_process, runs))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,65 @@
+#!/usr/bin/env python
+
+# Execution time of programs from tests/lit/execution built at -O2 by two
+# builds of tlang, for example before and after a change in inferred function
+# attributes and linkage.
+#
+# usage: function_attributes.py <old tlang> <new tlang> <clang> <library> <runs>
+# example: function_attributes.py old/cli build/cli clang \
+#     build/tests/lit/execution/liblibrary.a 20
+
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+PROGRAMS = os.path.join(os.path.dirname(__file__), "..", "lit", "execution",
+                        "programs")
+
+
+# exit code isn't checked, programs may fail on purpose
+def measure(command, runs):
+    result = []
+
+    for _ in range(runs):
+        begin = time.perf_counter()
+        subprocess.run(command, stdout=subprocess.DEVNULL)
+        result.append((time.perf_counter() - begin) * 1000)
+
+    return statistics.median(result)
+
+
+def build(tea_compiler, clang, library, program, tempdir):
+    obj = os.path.join(tempdir, "out.o")
+    exe = os.path.join(tempdir, "exe")
+
+    subprocess.run([tea_compiler, program, "--emit", "obj", "-O2", "-o", obj],
+                   check=True)
+    subprocess.run([clang, obj, library, "-o", exe], check=True)
+
+    return exe
+
+
+def main():
+    [_, old_compiler, new_compiler, clang, library, runs] = sys.argv
+    runs = int(runs)
+
+    print(f"{'program':>28} {'old ms':>10} {'new ms':>10} {'speedup':>8}")
+
+    for name in sorted(os.listdir(PROGRAMS)):
+        program = os.path.join(PROGRAMS, name)
+        times = []
+
+        for tea_compiler in [old_compiler, new_compiler]:
+            with tempfile.TemporaryDirectory() as tempdir:
+                exe = build(tea_compiler, clang, library, program, tempdir)
+                times.append(measure([exe], runs))
+
+        print(f"{name:>28} {times[0]:10.2f} {times[1]:10.2f} "
+              f"{times[0] / times[1]:8.2f}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,74 @@
+#!/usr/bin/env python
+
+# Size of unoptimized IR of programs from tests/lit/execution and time of
+# compiling them to object file at -O0, where LLVM doesn't clean IR up. Run it
+# on two builds of tlang to compare IR generation strategies.
+#
+# usage: ir_size.py <tlang> <runs>
+# example: ir_size.py build/cli 20
+
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+PROGRAMS = os.path.join(os.path.dirname(__file__), "..", "lit", "execution",
+                        "programs")
+
+
+def measure(command, runs):
+    result = []
+
+    for _ in range(runs):
+        begin = time.perf_counter()
+        subprocess.run(command, check=True, stdout=subprocess.DEVNULL)
+        result.append((time.perf_counter() - begin) * 1000)
+
+    return statistics.median(result)
+
+
+def count_instructions(tea_compiler, program):
+    ir = subprocess.run([tea_compiler, program, "--emit", "ir"], check=True,
+                        capture_output=True, text=True).stdout
+
+    counts = {"total": 0, "alloca": 0, "load": 0, "store": 0, "phi": 0}
+
+    # instructions are indented lines inside function bodies
+    for line in ir.splitlines():
+        if not line.startswith("  "):
+            continue
+
+        counts["total"] += 1
+        for kind in ["alloca", "load", "store", "phi"]:
+            if f" {kind} " in line or line.strip().startswith(f"{kind} "):
+                counts[kind] += 1
+
+    return counts
+
+
+def main():
+    [_, tea_compiler, runs] = sys.argv
+    runs = int(runs)
+
+    print(f"{'program':>28} {'instr':>6} {'alloca':>6} {'load':>6} "
+          f"{'store':>6} {'phi':>6} {'obj ms':>8}")
+
+    for name in sorted(os.listdir(PROGRAMS)):
+        program = os.path.join(PROGRAMS, name)
+        counts = count_instructions(tea_compiler, program)
+
+        with tempfile.TemporaryDirectory() as tempdir:
+            obj = os.path.join(tempdir, "out.o")
+            compile_time = measure(
+                [tea_compiler, program, "--emit", "obj", "-O0", "-o", obj],
+                runs)
+
+        print(f"{name:>28} {counts['total']:>6} {counts['alloca']:>6} "
+              f"{counts['load']:>6} {counts['store']:>6} {counts['phi']:>6} "
+              f"{compile_time:8.2f}")
+
+
+if __name__ == "__main__":
+    main()
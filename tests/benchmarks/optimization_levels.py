@@ -0,0 +1,70 @@
+#!/usr/bin/env python
+
+# Compile time and execution time of programs from tests/lit/execution at
+# each optimization level. Programs are compiled by tlang, then by llc at -O0,
+# so the difference in execution time comes from tlang pipelines only.
+#
+# usage: optimization_levels.py <tlang> <llc> <clang> <library> <runs>
+# example: optimization_levels.py build/cli llc clang \
+#     build/tests/lit/execution/liblibrary.a 20
+
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+LEVELS = ["-O0", "-O1", "-O2", "-O3", "-Os"]
+PROGRAMS = os.path.join(os.path.dirname(__file__), "..", "lit", "execution",
+                        "programs")
+
+
+# programs may exit with non-zero code on purpose, so it is checked only for
+# compiler
+def measure(command, runs, check=True):
+    result = []
+
+    for _ in range(runs):
+        begin = time.perf_counter()
+        subprocess.run(command, check=check, stdout=subprocess.DEVNULL)
+        result.append((time.perf_counter() - begin) * 1000)
+
+    return statistics.median(result)
+
+
+def build(tea_compiler, llc, clang, library, program, level, tempdir):
+    ir = os.path.join(tempdir, "out.ll")
+    asm = os.path.join(tempdir, "out.s")
+    exe = os.path.join(tempdir, "exe")
+
+    compile_command = [tea_compiler, program, level, "-o", ir]
+    compile_time = measure(compile_command, 1)
+
+    subprocess.run([llc, "-O0", ir, "-o", asm], check=True)
+    subprocess.run([clang, asm, library, "-o", exe], check=True)
+
+    return compile_time, exe
+
+
+def main():
+    [_, tea_compiler, llc, clang, library, runs] = sys.argv
+    runs = int(runs)
+
+    print(f"{'program':>28} {'level':>5} {'compile ms':>12} {'run ms':>10}")
+
+    for name in sorted(os.listdir(PROGRAMS)):
+        program = os.path.join(PROGRAMS, name)
+
+        for level in LEVELS:
+            with tempfile.TemporaryDirectory() as tempdir:
+                compile_time, exe = build(tea_compiler, llc, clang, library,
+                                          program, level, tempdir)
+                run_time = measure([exe], runs, check=False)
+
+            print(f"{name:>28} {level:>5} {compile_time:12.2f} "
+                  f"{run_time:10.2f}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,94 @@
+#!/usr/bin/env python
+
+# Compilation time of a generated project with many modules: one linked
+# module optimized and compiled by one thread compared with ThinLTO, which
+# optimizes and compiles modules separately in several threads.
+#
+# usage: thin_lto.py <tlang> <modules> <functions per module> <runs>
+# example: thin_lto.py build/cli 64 50 5
+
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+JOBS = [1, 2, 4, 8]
+
+
+def generate_module(index, functions):
+    lines = []
+    if index > 0:
+        lines.append(f'import "m{index - 1}"')
+
+    for function in range(functions):
+        name = f"m{index}_f{function}"
+        lines.append(f"export {name}: (x: i64) -> i64 = {{")
+        lines.append("    result: i64 = 0;")
+        lines.append("    i: i64 = 0;")
+        lines.append("    while (i < x) {")
+        lines.append(f"        result = result + i * {function + 1} % 7;")
+        lines.append("        i = i + 1;")
+        lines.append("    }")
+        if index > 0:
+            # calls across modules are candidates for import
+            lines.append(
+                f"    return result + m{index - 1}_f{function}(x % 7);")
+        else:
+            lines.append("    return result;")
+        lines.append("}")
+
+    return "\n".join(lines) + "\n"
+
+
+def generate_project(directory, modules, functions):
+    sources = []
+
+    for index in range(modules):
+        path = os.path.join(directory, f"m{index}.tea")
+        with open(path, "w") as file:
+            file.write(generate_module(index, functions))
+        sources.append(f"m{index}:{path}")
+
+    main = os.path.join(directory, "main.tea")
+    with open(main, "w") as file:
+        file.write(f'import "m{modules - 1}"\n\n'
+                   f"main: () -> i64 = {{\n"
+                   f"    return m{modules - 1}_f0(10);\n"
+                   f"}}\n")
+    sources.append(f"main:{main}")
+
+    return sources
+
+
+def measure(command, runs):
+    result = []
+
+    for _ in range(runs):
+        begin = time.perf_counter()
+        subprocess.run(command, check=True, stdout=subprocess.DEVNULL)
+        result.append((time.perf_counter() - begin) * 1000)
+
+    return statistics.median(result)
+
+
+def main():
+    [_, tea_compiler, modules, functions, runs] = sys.argv
+
+    with tempfile.TemporaryDirectory() as tempdir:
+        sources = generate_project(tempdir, int(modules), int(functions))
+        output = ["-o", os.path.join(tempdir, "out.o"), "--emit", "obj", "-O2"]
+
+        for jobs in JOBS:
+            common = [tea_compiler, *sources, *output, "-j", str(jobs)]
+
+            linked = measure(common, int(runs))
+            thin = measure([*common, "--thin-lto"], int(runs))
+
+            print(f"jobs {jobs:>2}: linked {linked:10.2f} ms, "
+                  f"ThinLTO {thin:10.2f} ms")
+
+
+if __name__ == "__main__":
+    main()
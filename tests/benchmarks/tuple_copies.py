@@ -0,0 +1,90 @@
+#!/usr/bin/env python
+
+# Memory traffic of tuple copies in unoptimized IR: allocas, loads, stores and
+# memcpy calls for programs from tests/lit/execution and for generated code
+# that builds, passes and returns nested tuples. Run it on two builds of tlang
+# to compare copy elision strategies.
+#
+# usage: tuple_copies.py <tlang> [functions]
+# example: tuple_copies.py build/cli 200
+
+import os
+import subprocess
+import sys
+import tempfile
+
+PROGRAMS = os.path.join(os.path.dirname(__file__), "..", "lit", "execution",
+                        "programs")
+
+KINDS = ["alloca", "load", "store", "memcpy"]
+
+
+def generate_program(functions):
+    lines = ["T: type == ((i64, i64), (i64, i64))", ""]
+
+    for i in range(functions):
+        lines += [
+            f"make_{i}: (a: i64) -> T = {{",
+            "    return ((a, a + 1), (a + 2, a + 3));",
+            "}",
+            "",
+            f"use_{i}: (a: i64) -> i64 = {{",
+            f"    tuple: T = make_{i}(a);",
+            "    copy: T = tuple;",
+            "    copy.0.0 = copy.1.1;",
+            f"    pair: (T, T) = (copy, make_{i}(a));",
+            "    return pair.0.0.0 + pair.1.1.1;",
+            "}",
+            "",
+        ]
+
+    return "\n".join(lines)
+
+
+def count_instructions(tea_compiler, program):
+    ir = subprocess.run([tea_compiler, program, "--emit", "ir"], check=True,
+                        capture_output=True, text=True).stdout
+
+    counts = {kind: 0 for kind in KINDS}
+
+    # instructions are indented lines inside function bodies
+    for line in ir.splitlines():
+        if not line.startswith("  "):
+            continue
+
+        line = line.strip()
+        for kind in ["alloca", "load", "store"]:
+            if f" {kind} " in line or line.startswith(f"{kind} "):
+                counts[kind] += 1
+
+        if "@llvm.memcpy" in line:
+            counts["memcpy"] += 1
+
+    return counts
+
+
+def print_counts(name, counts):
+    print(f"{name:>28} " + " ".join(f"{counts[kind]:>7}" for kind in KINDS))
+
+
+def main():
+    tea_compiler = sys.argv[1]
+    functions = int(sys.argv[2]) if len(sys.argv) > 2 else 100
+
+    print(f"{'program':>28} " + " ".join(f"{kind:>7}" for kind in KINDS))
+
+    for name in sorted(os.listdir(PROGRAMS)):
+        program = os.path.join(PROGRAMS, name)
+        print_counts(name, count_instructions(tea_compiler, program))
+
+    with tempfile.TemporaryDirectory() as tempdir:
+        program = os.path.join(tempdir, "nested_tuples.tea")
+        with open(program, "w") as file:
+            file.write(generate_program(functions))
+
+        print_counts(f"nested_tuples x{functions}",
+                     count_instructions(tea_compiler, program))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,102 @@
+#!/usr/bin/env python
+
+# Throughput of AST visitors: wall time of semantic analysis and IR generation
+# phases from --time-report on a generated program with many small functions,
+# for two builds of tlang, for example before and after a change in
+# ASTVisitor dispatch. Time is reported per generated function, each one has
+# about a hundred AST nodes.
+#
+# usage: visitor_throughput.py <old tlang> <new tlang> <runs> [functions]
+# example: visitor_throughput.py old/cli build/cli 20 2000
+
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+
+PHASES = ["semantic analysis", "IR generation"]
+
+
+def generate_program(functions):
+    lines = ["T: type == (i64, i64)", ""]
+
+    for i in range(functions):
+        lines += [
+            f"f_{i}: (a: i64, b: i64) -> i64 = {{",
+            "    pair: T = (a + 1, b * 2);",
+            "    sum: i64 = 0;",
+            "    i: i64 = 0;",
+            "    while (i < a) {",
+            "        if (i % 3 == 0) {",
+            "            if (!(pair.0 > b)) {",
+            "                sum = sum + pair.0 * i - pair.1;",
+            "            }",
+            "        } else {",
+            "            sum = sum - (i + b) % 7;",
+            "        }",
+            "        i = i + 1;",
+            "    }",
+            "    return sum + pair.1;",
+            "}",
+            "",
+        ]
+
+    lines += [
+        "main: () -> i64 = {",
+        f"    return f_{functions - 1}(10, 20);",
+        "}",
+    ]
+
+    return "\n".join(lines) + "\n"
+
+
+# wall time of top-level rows of the phases in milliseconds
+def read_phases(report):
+    result = {}
+
+    for line in report.splitlines():
+        fields = line.split(None, 4)
+        if len(fields) == 5 and fields[4] in PHASES:
+            result[fields[4]] = float(fields[0]) * 1000
+
+    return result
+
+
+def measure(tea_compiler, program, output, runs):
+    times = {phase: [] for phase in PHASES}
+
+    for _ in range(runs):
+        report = subprocess.run(
+            [tea_compiler, program, "--emit", "ir", "-O0", "--time-report",
+             "-o", output], check=True, capture_output=True, text=True).stderr
+
+        for phase, time in read_phases(report).items():
+            times[phase].append(time)
+
+    return {phase: statistics.median(values) for phase, values in times.items()}
+
+
+def main():
+    tea_compilers = sys.argv[1:3]
+    runs = int(sys.argv[3])
+    functions = int(sys.argv[4]) if len(sys.argv) > 4 else 2000
+
+    with tempfile.TemporaryDirectory() as tempdir:
+        program = os.path.join(tempdir, "program.tea")
+        with open(program, "w") as file:
+            file.write(generate_program(functions))
+
+        output = os.path.join(tempdir, "out.ll")
+        results = [measure(tea_compiler, program, output, runs)
+                   for tea_compiler in tea_compilers]
+
+    for phase in PHASES:
+        [old, new] = [result[phase] for result in results]
+        print(f"{phase:>18}: old {old * 1000 / functions:8.2f} us/function, "
+              f"new {new * 1000 / functions:8.2f} us/function, "
+              f"speedup {old / new:5.2f}x")
+
+
+if __name__ == "__main__":
+    main()
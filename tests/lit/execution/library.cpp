@@ -1,3 +1,4 @@
+#include <cstdint>
 #include <iostream>
 
 void print(int64_t value) {
@@ -6,4 +7,56 @@ void print(int64_t value) {
 
 void println(int64_t value) {
   std::cout << value << "\n";
-}
\ No newline at end of file
+}
+
+// tuples are passed to C++ as structs with the same elements, they check that
+// both sides classify arguments and results the same way. Tea mangles tuples
+// as vendor types, so symbols are named explicitly
+#define STRINGIFY_IMPL(value) #value
+#define STRINGIFY(value) STRINGIFY_IMPL(value)
+#define TEA_SYMBOL(name) __asm__(STRINGIFY(__USER_LABEL_PREFIX__) name)
+
+struct Pair {
+  int64_t first;
+  int64_t second;
+};
+
+struct Flagged {
+  int64_t value;
+  bool flag;
+};
+
+struct Triple {
+  int64_t first;
+  int64_t second;
+  int64_t third;
+};
+
+Pair cpp_make_pair(int64_t first, int64_t second)
+    TEA_SYMBOL("_Z13cpp_make_pairxx");
+Pair cpp_swap(Pair pair) TEA_SYMBOL("_Z8cpp_swapu5tupleIxxE");
+Flagged cpp_toggle(Flagged flagged) TEA_SYMBOL("_Z10cpp_toggleu5tupleIxbE");
+Triple cpp_rotate(Triple triple) TEA_SYMBOL("_Z10cpp_rotateu5tupleIxxxE");
+int64_t cpp_sum_spilled(int64_t a, int64_t b, int64_t c, int64_t d, int64_t e,
+                        Pair pair, int64_t last)
+    TEA_SYMBOL("_Z15cpp_sum_spilledxxxxxu5tupleIxxEx");
+
+Pair cpp_make_pair(int64_t first, int64_t second) { return {first, second}; }
+
+Pair cpp_swap(Pair pair) { return {pair.second, pair.first}; }
+
+Flagged cpp_toggle(Flagged flagged) {
+  return {flagged.value * 2, !flagged.flag};
+}
+
+Triple cpp_rotate(Triple triple) {
+  return {triple.second, triple.third, triple.first};
+}
+
+// five integers leave one register, so the pair goes to the stack and the
+// last argument takes the register
+int64_t cpp_sum_spilled(int64_t a, int64_t b, int64_t c, int64_t d, int64_t e,
+                        Pair pair, int64_t last) {
+  return a + 2 * b + 3 * c + 4 * d + 5 * e + 6 * pair.first +
+         7 * pair.second + 8 * last;
+}
@@ -16,8 +16,8 @@ config.substitutions.append(("%FileCheck", config.llvm_filecheck))
 config.substitutions.append(("%llc", config.llvm_llc))
 config.substitutions.append(("%clang", config.llvm_clang))
 
-executor = os.path.join(config.src_root, 'tests/lit/execution/executor.py')
-execute_order = f"{executor} {config.tea_path} {config.library} {config.llvm_llc} {config.llvm_clang}"
+# programs are executed by JIT in compiler process
+execute_order = f"{config.tea_path} run --load {config.shared_library}"
 config.substitutions.append(("%execute", execute_order))
 
 config.test_format = lit.formats.ShTest()
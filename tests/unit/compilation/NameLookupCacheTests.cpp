@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include "ast/Nodes.h"
+#include "compilation/Scope.h"
+
+using namespace Front;
+
+class NameLookupCacheTests : public ::testing::Test {
+ protected:
+  StringPool strings;
+  NameLookupCache cache;
+
+  StringId a = strings.add_string("a");
+  StringId b = strings.add_string("b");
+
+  Scope root{strings.add_string("")};
+
+  VariableDecl variable{{}, a, nullptr, nullptr};
+  NamespaceDecl nmsp{{}, a, {}};
+
+  void SetUp() override { root.lookup_cache = &cache; }
+};
+
+TEST_F(NameLookupCacheTests, cached_result_is_hit) {
+  SymbolInfo& info = root.add_variable(a, variable, nullptr);
+
+  ASSERT_FALSE(cache.find(&root, QualifiedId{{a}}).has_value());
+  cache.insert(&root, QualifiedId{{a}}, &info);
+
+  ASSERT_EQ(cache.find(&root, QualifiedId{{a}}), &info);
+  ASSERT_EQ(cache.hits(), 1);
+  ASSERT_EQ(cache.misses(), 1);
+}
+
+TEST_F(NameLookupCacheTests, other_scope_or_id_is_miss) {
+  Scope& child = root.add_child(b);
+  cache.insert(&root, QualifiedId{{a}}, nullptr);
+
+  ASSERT_FALSE(cache.find(&child, QualifiedId{{a}}).has_value());
+  ASSERT_FALSE(cache.find(&root, QualifiedId{{a, b}}).has_value());
+  ASSERT_FALSE(cache.find(&root, QualifiedId{{b}}).has_value());
+
+  // not found symbol is cached too
+  ASSERT_EQ(cache.find(&root, QualifiedId{{a}}), nullptr);
+  ASSERT_EQ(cache.hits(), 1);
+  ASSERT_EQ(cache.misses(), 3);
+}
+
+TEST_F(NameLookupCacheTests, shadowing_symbol_invalidates_group) {
+  SymbolInfo& outer = root.add_variable(a, variable, nullptr);
+  Scope& child = root.add_child(b);
+
+  cache.insert(&child, QualifiedId{{a}}, &outer);
+  cache.insert(&child, QualifiedId{{a, b}}, nullptr);
+  cache.insert(&child, QualifiedId{{b}}, nullptr);
+
+  child.add_variable(a, variable, nullptr);
+
+  ASSERT_FALSE(cache.find(&child, QualifiedId{{a}}).has_value());
+  ASSERT_FALSE(cache.find(&child, QualifiedId{{a, b}}).has_value());
+  ASSERT_TRUE(cache.find(&child, QualifiedId{{b}}).has_value());
+}
+
+TEST_F(NameLookupCacheTests, injected_import_invalidates_cached_miss) {
+  cache.insert(&root, QualifiedId{{a, b}}, nullptr);
+
+  // semantic analyzer injects imported namespace on first lookup of its name
+  Scope& subscope = root.add_child(a);
+  root.add_namespace(a, nmsp, &subscope);
+
+  ASSERT_FALSE(cache.find(&root, QualifiedId{{a, b}}).has_value());
+
+  // members are injected lazily as well
+  cache.insert(&subscope, QualifiedId{{b}}, nullptr);
+  subscope.add_variable(b, variable, nullptr);
+
+  ASSERT_FALSE(cache.find(&subscope, QualifiedId{{b}}).has_value());
+}
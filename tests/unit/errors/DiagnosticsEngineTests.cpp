@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "errors/DiagnosticsEngine.h"
+
+namespace {
+SourceRange make_range(SourceView view, size_t begin, size_t end) {
+  SourceLocation location = view.begin_location();
+  return {SourceLocation(location.file_id, location.pos_id + begin),
+          SourceLocation(location.file_id, location.pos_id + end)};
+}
+}  // namespace
+
+TEST(DiagnosticsEngineTests, repeated_diagnostics_are_dropped) {
+  SourceManager source_manager;
+  SourceView view = source_manager.load_text("a: i32 = 0;\nb: i32 = c;\n");
+
+  std::stringstream ss;
+  DiagnosticsEngine diagnostics(source_manager, ss, DiagnosticsFormat::JSON);
+
+  diagnostics.error(make_range(view, 21, 22), "Unknown name c");
+  diagnostics.error(make_range(view, 21, 22), "Unknown name c");
+  diagnostics.error(make_range(view, 21, 22), "Other error");
+
+  ASSERT_EQ(diagnostics.get_errors_count(), 2);
+
+  std::string line;
+  std::getline(ss, line);
+  ASSERT_EQ(line,
+            R"({"severity":"error","file":"","line":2,"column":10,)"
+            R"("end_line":2,"end_column":11,"message":"Unknown name c"})");
+
+  std::getline(ss, line);
+  ASSERT_TRUE(line.contains("Other error"));
+  ASSERT_FALSE(std::getline(ss, line));
+}
+
+TEST(DiagnosticsEngineTests, diagnostics_differing_in_one_field_are_kept) {
+  SourceManager source_manager;
+  SourceView view = source_manager.load_text("a: i32 = b;\n");
+
+  std::stringstream ss;
+  DiagnosticsEngine diagnostics(source_manager, ss, DiagnosticsFormat::JSON);
+
+  diagnostics.error(make_range(view, 9, 10), "Unknown name b");
+  diagnostics.error(make_range(view, 9, 11), "Unknown name b");
+  diagnostics.error(make_range(view, 8, 10), "Unknown name b");
+  diagnostics.report(Severity::WARNING, make_range(view, 9, 10),
+                     "Unknown name b");
+
+  ASSERT_EQ(diagnostics.get_errors_count(), 3);
+
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(ss, line);) {
+    lines.push_back(line);
+  }
+
+  ASSERT_EQ(lines.size(), 4);
+  ASSERT_TRUE(lines.back().contains(R"("severity":"warning")"));
+}
+
+TEST(DiagnosticsEngineTests, errors_after_limit_are_dropped) {
+  SourceManager source_manager;
+  SourceView view = source_manager.load_text("x x x x x");
+
+  std::stringstream ss;
+  DiagnosticsEngine diagnostics(source_manager, ss, DiagnosticsFormat::JSON,
+                                2);
+
+  ASSERT_EQ(diagnostics.get_remaining_errors(), 2);
+
+  for (size_t i = 0; i < 5; ++i) {
+    diagnostics.error(make_range(view, 2 * i, 2 * i + 1), "Unexpected x");
+  }
+
+  ASSERT_TRUE(diagnostics.has_reached_limit());
+  ASSERT_EQ(diagnostics.get_errors_count(), 2);
+  ASSERT_EQ(diagnostics.get_remaining_errors(), 0);
+
+  // two errors and note about the limit
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(ss, line);) {
+    lines.push_back(line);
+  }
+
+  ASSERT_EQ(lines.size(), 3);
+  ASSERT_TRUE(lines.back().contains(R"("severity":"note")"));
+}
+
+TEST(DiagnosticsEngineTests, text_format_points_to_range) {
+  SourceManager source_manager;
+  SourceView view = source_manager.load_text("first\nsecond line\n");
+
+  std::stringstream ss;
+  DiagnosticsEngine diagnostics(source_manager, ss);
+  diagnostics.report(Severity::WARNING, make_range(view, 13, 17), "message");
+
+  std::string line;
+  std::getline(ss, line);
+  ASSERT_EQ(line, ":2:8: warning:");
+
+  std::getline(ss, line);
+  ASSERT_TRUE(line.starts_with("second "));
+
+  std::getline(ss, line);
+  ASSERT_EQ(line, "       `-message");
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "SyntaxTestCase.h"
+#include "ast/ASTPrinter.h"
+#include "ast/ASTSerializer.h"
+
+std::string print_ast(const ModuleContext& context) {
+  std::stringstream ss;
+  ASTPrinter(context, ss).print();
+  return ss.str();
+}
+
+TEST_F(SyntaxTestCase, ast_serialization_roundtrip) {
+  auto& context = parse(R"(
+    import "io"
+
+    export math: namespace = {
+      Pair: type == (i32, *u64)
+
+      abs: (x: i32) -> i32 = {
+        if (x < 0) {
+          return -x;
+        } else {
+          return x;
+        }
+      }
+    }
+
+    Point: type = {
+      x: i32
+      y: i32
+    }
+
+    extern print: (value: i64) -> ()
+
+    main: () -> i64 = {
+      value: i64 = -123456789;
+      while (value != 0) {
+        value = math::abs(value % 10);
+        break;
+      }
+
+      pair: (i64, b8, *c8) = (value, true, "string");
+      return pair.0;
+    }
+  )");
+
+  std::stringstream ss;
+  ASTSerializer::serialize(ss, context);
+
+  ModuleContext loaded;
+  loaded.ast_root = ASTSerializer::deserialize(ss, loaded, 0);
+
+  ASSERT_EQ(print_ast(loaded), print_ast(context));
+}
+
+TEST_F(SyntaxTestCase, ast_deserialization_of_truncated_input) {
+  auto& context = parse("f: (x: i32) -> i32 = { return x * 2; }");
+
+  std::stringstream ss;
+  ASTSerializer::serialize(ss, context);
+  std::string bytes = ss.str();
+
+  for (size_t size = 0; size < bytes.size(); ++size) {
+    std::stringstream truncated(bytes.substr(0, size));
+    ModuleContext loaded;
+
+    ASSERT_THROW(ASTSerializer::deserialize(truncated, loaded, 0),
+                 ASTDeserializationException);
+  }
+}
+
+TEST_F(SyntaxTestCase, module_interface_serialization) {
+  auto& context = parse(R"(
+    export Point: type = {
+      x: i32
+    }
+
+    helper: () -> i32 = { return 1; }
+
+    api: namespace = {
+      export get: () -> i32 = { return helper(); }
+      hidden: () -> i32 = { return 2; }
+    }
+
+    export visible: namespace = {
+      f: () -> () = {}
+    }
+  )");
+
+  std::stringstream ss;
+  ASTSerializer::serialize_interface(ss, context);
+
+  ModuleContext loaded;
+  loaded.ast_root = ASTSerializer::deserialize(ss, loaded, 0);
+
+  const auto& declarations = loaded.ast_root->declarations;
+  ASSERT_EQ(declarations.size(), 3);
+  ASSERT_EQ(declarations[0]->get_kind(), ASTNode::Kind::CLASS_DECL);
+
+  const auto& api = dynamic_cast<const NamespaceDecl&>(*declarations[1]);
+  ASSERT_EQ(api.body.size(), 1);
+
+  const auto& get = dynamic_cast<const FunctionDecl&>(*api.body[0]);
+  ASSERT_EQ(loaded.get_string(get.name), "get");
+  ASSERT_TRUE(get.specifiers.is_exported());
+  ASSERT_TRUE(get.specifiers.is_extern());
+  ASSERT_EQ(get.body, nullptr);
+
+  const auto& visible = dynamic_cast<const NamespaceDecl&>(*declarations[2]);
+  ASSERT_EQ(visible.body.size(), 1);
+}
@@ -91,3 +91,13 @@ TEST_F(SyntaxTestCase, test_it_recovers_from_errors_in_semicolons_sequence) {
     }
   }
 }
+
+TEST_F(SyntaxTestCase, test_it_stops_after_max_errors) {
+  auto program = "f: () -> void = { error!; func(); another!; }";
+  MY_ASSERT_THROW(parse(program, 1), ParserException exception) {
+    auto errors = exception.get_errors();
+
+    ASSERT_EQ(errors.size(), 1);
+    ASSERT_SOURCE_RANGE(errors[0].first, 23, 24);
+  }
+}
@@ -52,7 +52,9 @@ class SyntaxTestCase : public ::testing::Test {
     return true;
   }
 
-  const ModuleContext& parse(std::string_view program) {
+  const ModuleContext& parse(
+      std::string_view program,
+      size_t max_errors = std::numeric_limits<size_t>::max()) {
     // reset global context for each parse
     delete context_;
     context_ = new GlobalContext();
@@ -66,7 +68,7 @@ class SyntaxTestCase : public ::testing::Test {
 
     Syntax::LRParser parser(
         Constants::GetRuntimeFilePath(Constants::grammar_relative_filepath));
-    parser.parse(lexical_analyzer, module_context, source_view);
+    parser.parse(lexical_analyzer, module_context, source_view, max_errors);
 
     return module_context;
   }
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "utils/SmallVector.h"
+
+using Vector = SmallVector<size_t, 3>;
+
+template <typename R>
+std::vector<size_t> to_std_vector(const R& range) {
+  return std::vector<size_t>(range.begin(), range.end());
+}
+
+TEST(SmallVectorTests, test_push_and_pop) {
+  Vector vector;
+  ASSERT_TRUE(vector.empty());
+
+  for (size_t i = 0; i < 10; ++i) {
+    vector.push_back(i);
+    ASSERT_EQ(vector.size(), i + 1);
+    ASSERT_EQ(vector.back(), i);
+  }
+
+  ASSERT_EQ(to_std_vector(vector),
+            (std::vector<size_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+  vector.pop_back();
+  vector.pop_back();
+  ASSERT_EQ(vector.size(), 8);
+  ASSERT_EQ(vector.front(), 0);
+  ASSERT_EQ(vector.back(), 7);
+}
+
+TEST(SmallVectorTests, test_push_own_element) {
+  Vector vector{1, 2, 3};
+
+  // reallocation happens here
+  vector.push_back(vector[0]);
+
+  ASSERT_EQ(to_std_vector(vector), (std::vector<size_t>{1, 2, 3, 1}));
+}
+
+TEST(SmallVectorTests, test_copy_and_move) {
+  Vector small{1, 2};
+  Vector big{1, 2, 3, 4, 5};
+
+  Vector small_copy = small;
+  Vector big_copy = big;
+  ASSERT_EQ(small_copy, small);
+  ASSERT_EQ(big_copy, big);
+
+  Vector small_moved = std::move(small_copy);
+  Vector big_moved = std::move(big_copy);
+  ASSERT_EQ(small_moved, small);
+  ASSERT_EQ(big_moved, big);
+
+  small_moved = big;
+  ASSERT_EQ(small_moved, big);
+
+  big_moved = std::move(small);
+  ASSERT_EQ(to_std_vector(big_moved), (std::vector<size_t>{1, 2}));
+}
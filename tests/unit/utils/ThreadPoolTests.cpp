@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+#include "utils/ThreadPool.h"
+
+TEST(ThreadPoolTests, test_all_tasks_are_executed) {
+  std::atomic<size_t> counter{0};
+
+  ThreadPool pool(4);
+  for (size_t i = 0; i < 1000; ++i) {
+    pool.submit([&counter] { ++counter; });
+  }
+  pool.wait();
+
+  ASSERT_EQ(counter, 1000);
+}
+
+TEST(ThreadPoolTests, test_tasks_submitted_from_tasks) {
+  std::atomic<size_t> counter{0};
+  ThreadPool pool(4);
+
+  // binary tree of tasks with depth 10
+  std::function<void(size_t)> spawn = [&](size_t depth) {
+    ++counter;
+
+    if (depth > 0) {
+      pool.submit([&spawn, depth] { spawn(depth - 1); });
+      pool.submit([&spawn, depth] { spawn(depth - 1); });
+    }
+  };
+
+  pool.submit([&spawn] { spawn(10); });
+  pool.wait();
+
+  ASSERT_EQ(counter, (1 << 11) - 1);
+}